@@ -1,5 +1,11 @@
+#include <charconv>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <thread>
 #include <vector>
@@ -7,7 +13,11 @@
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
 
+#include <numero/aggregate.h>
+#include <numero/corpus.h>
 #include <numero/numero.h>
+#include <numero/result_cache.h>
+#include <numero/text_scanner.h>
 
 using hr_clock = std::chrono::high_resolution_clock;
 
@@ -36,7 +46,7 @@ struct conversion_t
     bool error;
 };
 
-void convert_inputs(const std::vector<std::string> &inputs,
+void convert_inputs(const std::vector<std::string_view> &inputs,
                     std::vector<conversion_t> &conversions,
                     const std::size_t start_index,
                     const std::size_t increment,
@@ -89,6 +99,612 @@ void convert_inputs(const std::vector<std::string> &inputs,
     }
 }
 
+struct record_field_t
+{
+    std::size_t begin;
+    std::size_t end;
+    std::size_t record;
+    std::size_t column;
+    std::string result;
+    bool converted;
+};
+
+/*
+ * Converts the selected columns of delimiter separated records, e.g. CSV or TSV, and copies everything else through
+ * as it is. The records are read in blocks; the selected fields of each block are converted in parallel and the block
+ * is written with the converted fields in place of the original ones. Fields are quoted according to RFC 4180 if
+ * quoting is enabled, which applies to reading as well as to writing fields.
+ * \returns the number of fields that could not be converted.
+ */
+std::size_t convert_records(std::istream &input, std::ostream &output, const std::vector<std::size_t> &columns,
+                            const char delimiter, const bool quoting, const bool header, num::converter_c &converter,
+                            const std::size_t jobs_count, const bool use_colors)
+{
+    constexpr std::size_t block_size = 1 << 22;
+
+    std::vector<bool> selected;
+    for (const auto column : columns)
+    {
+        if (column >= selected.size())
+            selected.resize(column + 1);
+        selected[column] = true;
+    }
+
+    std::string buffer;
+    std::vector<record_field_t> fields;
+    std::size_t record = 0;
+    std::size_t failure_count = 0;
+    bool end_of_input = false;
+
+    while (!end_of_input)
+    {
+        const auto buffer_size = buffer.size();
+        buffer.resize(buffer_size + block_size);
+        input.read(buffer.data() + buffer_size, block_size);
+        buffer.resize(buffer_size + static_cast<std::size_t>(input.gcount()));
+        end_of_input = !input;
+
+        // Find the selected fields of all records that are complete within the buffer.
+        std::size_t consumed = 0;
+        fields.clear();
+
+        while (consumed < buffer.size())
+        {
+            const auto fields_count = fields.size();
+            auto position = consumed;
+            bool complete = false;
+
+            for (std::size_t column = 1;; column++)
+            {
+                const auto begin = position;
+
+                if (quoting && position < buffer.size() && buffer[position] == '"')
+                {
+                    for (position++; position < buffer.size(); position++)
+                    {
+                        if (buffer[position] != '"')
+                            continue;
+                        if (position + 1 < buffer.size() && buffer[position + 1] == '"')
+                            position++;
+                        else
+                            break;
+                    }
+
+                    // A quote at the very end of the buffer may be the first one of an escaped quote.
+                    if (position + 1 >= buffer.size() && !end_of_input)
+                        break;
+                    position++;
+                }
+
+                for (; position < buffer.size() && buffer[position] != delimiter && buffer[position] != '\n';
+                     position++);
+
+                if (position == buffer.size() && !end_of_input)
+                    break;
+
+                const auto end = position > begin && position < buffer.size() && buffer[position - 1] == '\r' ?
+                                 position - 1 : position;
+
+                if (column < selected.size() && selected[column] && !(header && record == 0))
+                    fields.push_back({ begin, end, record, column, {}, false });
+
+                if (position < buffer.size() && buffer[position] == delimiter)
+                {
+                    position++;
+                    continue;
+                }
+
+                complete = true;
+                position = std::min(position + 1, buffer.size());
+                break;
+            }
+
+            if (!complete)
+            {
+                fields.resize(fields_count);
+                break;
+            }
+
+            consumed = position;
+            record++;
+        }
+
+        const auto convert_fields = [&](const std::size_t start_index, const std::size_t increment) {
+            std::string value;
+
+            for (auto i = start_index; i < fields.size(); i += increment)
+            {
+                auto &field = fields[i];
+                const auto raw = std::string_view(buffer).substr(field.begin, field.end - field.begin);
+
+                value.clear();
+                if (quoting && raw.size() >= 2 && raw.front() == '"' && raw.back() == '"')
+                {
+                    for (std::size_t j = 1; j + 1 < raw.size(); j++)
+                    {
+                        value += raw[j];
+                        if (raw[j] == '"')
+                            j++;
+                    }
+                }
+                else
+                    value = raw;
+
+                if (value.empty())
+                    continue;
+
+                try
+                {
+                    field.result = converter.convert(value);
+                    field.converted = true;
+                }
+                catch (const std::exception &ex)
+                {
+                    field.result = ex.what();
+                }
+            }
+        };
+
+        const auto threads_count = std::max<std::size_t>(1, std::min<std::size_t>(fields.size() / 100, jobs_count));
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 1; i < threads_count; i++)
+            threads.emplace_back(convert_fields, i, threads_count);
+
+        convert_fields(0, threads_count);
+
+        for (auto &thread : threads)
+            thread.join();
+
+        // Write the block with the converted fields in place of the original ones.
+        std::size_t written = 0;
+
+        for (const auto &field : fields)
+        {
+            output.write(buffer.data() + written, static_cast<std::streamsize>(field.begin - written));
+            written = field.begin;
+
+            if (!field.converted)
+            {
+                if (!field.result.empty())
+                {
+                    std::cerr << (use_colors ? "\033[31m" : "")
+                              << boost::format("Error in record %1%, column %2%: %3%") % (field.record + 1)
+                                               % field.column % field.result
+                              << (use_colors ? "\033[0m\n" : "\n");
+                    failure_count++;
+                }
+
+                continue;
+            }
+
+            if (quoting && field.result.find_first_of(std::string { delimiter, '"', '\r', '\n' }) != std::string::npos)
+            {
+                output << '"';
+                for (const auto c : field.result)
+                    output << (c == '"' ? "\"\"" : std::string(1, c));
+                output << '"';
+            }
+            else
+                output << field.result;
+
+            written = field.end;
+        }
+
+        output.write(buffer.data() + written, static_cast<std::streamsize>(consumed - written));
+        buffer.erase(0, consumed);
+    }
+
+    output.flush();
+    return failure_count;
+}
+
+struct shard_t
+{
+    std::size_t index = 0;
+    std::size_t count = 0;
+};
+
+/*
+ * Manifest of the output of one shard of an input file. It is written next to the output, so that the outputs of all
+ * shards can be verified and stitched together in shard order. The range of a shard is given in bytes of a text file
+ * or in inputs of a binary corpus. The input is identified by the size and modification time of its file rather than
+ * by its path, which may differ between the machines that the shards run on, and each shard records the checksum of
+ * its own range only, so that no shard reads more of the input than its range.
+ */
+struct shard_manifest_t
+{
+    shard_t shard;
+    std::string input_file;
+    uint64_t input_file_size = 0;
+    int64_t input_file_time = 0;
+    std::string unit;
+    uint64_t input_size = 0;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    uint64_t range_checksum = 0;
+    uint64_t output_size = 0;
+    uint64_t output_checksum = 0;
+};
+
+constexpr std::string_view shard_manifest_magic = "numero shard manifest 3";
+constexpr uint64_t fnv_offset_basis = 0xcbf29ce484222325;
+
+/*
+ * Continues the 64-bit FNV-1a hash of preceding bytes with the given ones.
+ */
+uint64_t hash_bytes(const std::string_view &bytes, uint64_t hash)
+{
+    for (const auto byte : bytes)
+        hash = (hash ^ static_cast<uint8_t>(byte)) * 0x100000001b3;
+
+    return hash;
+}
+
+/*
+ * Gets the size and the modification time of a file, which identify the input of the shards.
+ */
+void stat_input_file(const std::string &path, shard_manifest_t &manifest)
+{
+    manifest.input_file_size = std::filesystem::file_size(path);
+    manifest.input_file_time = static_cast<int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+}
+
+/*
+ * Computes the 64-bit FNV-1a hash and the size of a file.
+ */
+uint64_t hash_file(const std::string &path, uint64_t &out_size)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        const auto message = boost::format("unable to open file \"%1%\"") % path;
+        throw std::invalid_argument(message.str());
+    }
+
+    uint64_t hash = fnv_offset_basis;
+    std::vector<char> buffer(1 << 16);
+    out_size = 0;
+
+    while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+    {
+        const auto read = static_cast<std::size_t>(file.gcount());
+        hash = hash_bytes(std::string_view(buffer.data(), read), hash);
+        out_size += read;
+    }
+
+    return hash;
+}
+
+void write_shard_manifest(const std::string &path, const shard_manifest_t &manifest)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << shard_manifest_magic << "\n"
+         << "shard " << manifest.shard.index << "/" << manifest.shard.count << "\n"
+         << "input-file " << manifest.input_file << "\n"
+         << "input-file-size " << manifest.input_file_size << "\n"
+         << "input-file-time " << manifest.input_file_time << "\n"
+         << "unit " << manifest.unit << "\n"
+         << "input-size " << manifest.input_size << "\n"
+         << "range " << manifest.begin << " " << manifest.end << "\n"
+         << "range-checksum " << std::hex << manifest.range_checksum << std::dec << "\n"
+         << "output-size " << manifest.output_size << "\n"
+         << "output-checksum " << std::hex << manifest.output_checksum << std::dec << "\n";
+
+    if (!file.flush())
+    {
+        const auto message = boost::format("unable to write shard manifest \"%1%\"") % path;
+        throw std::runtime_error(message.str());
+    }
+}
+
+shard_manifest_t read_shard_manifest(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+
+    if (!file || !std::getline(file, line) || line != shard_manifest_magic)
+    {
+        const auto message = boost::format("\"%1%\" is not a valid shard manifest") % path;
+        throw std::invalid_argument(message.str());
+    }
+
+    shard_manifest_t manifest;
+    char separator;
+
+    while (std::getline(file, line))
+    {
+        const auto key_end = std::min(line.find(' '), line.size());
+        const auto key = line.substr(0, key_end);
+        std::istringstream value(line.substr(std::min(key_end + 1, line.size())));
+
+        if (key == "shard")
+            value >> manifest.shard.index >> separator >> manifest.shard.count;
+        else if (key == "input-file")
+            manifest.input_file = value.str();
+        else if (key == "input-file-size")
+            value >> manifest.input_file_size;
+        else if (key == "input-file-time")
+            value >> manifest.input_file_time;
+        else if (key == "unit")
+            value >> manifest.unit;
+        else if (key == "input-size")
+            value >> manifest.input_size;
+        else if (key == "range")
+            value >> manifest.begin >> manifest.end;
+        else if (key == "range-checksum")
+            value >> std::hex >> manifest.range_checksum;
+        else if (key == "output-size")
+            value >> manifest.output_size;
+        else if (key == "output-checksum")
+            value >> std::hex >> manifest.output_checksum;
+
+        if (value.fail())
+        {
+            const auto message = boost::format("invalid line \"%1%\" in shard manifest \"%2%\"") % line % path;
+            throw std::invalid_argument(message.str());
+        }
+    }
+
+    return manifest;
+}
+
+/*
+ * Finds the beginning of the first line of a file that begins at or after the given offset, so that a shard starts
+ * right after the line in which the previous one ends.
+ */
+uint64_t align_to_line(std::istream &file, const uint64_t offset, const uint64_t size)
+{
+    if (offset == 0 || offset >= size)
+        return std::min(offset, size);
+
+    std::string rest;
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset - 1));
+    std::getline(file, rest);
+
+    return std::min(offset + rest.size(), size);
+}
+
+/*
+ * Verifies the outputs of all shards of an input file against their manifests and writes them in shard order.
+ * \throws std::invalid_argument exception if a shard is missing, if shards overlap or leave gaps, or if an output
+ *   does not match its manifest.
+ */
+void merge_shards(const std::vector<std::string> &output_files, std::ostream &output)
+{
+    std::vector<std::pair<shard_manifest_t, std::string>> shards;
+    for (const auto &output_file : output_files)
+        shards.emplace_back(read_shard_manifest(output_file + ".manifest"), output_file);
+
+    std::sort(shards.begin(), shards.end(), [](const auto &a, const auto &b) {
+        return a.first.shard.index < b.first.shard.index;
+    });
+
+    const auto &first = shards.front().first;
+
+    for (std::size_t i = 0; i < shards.size(); i++)
+    {
+        const auto &[manifest, output_file] = shards[i];
+
+        if (manifest.shard.count != shards.size() || manifest.shard.index != i + 1)
+        {
+            const auto message = boost::format("expected shard %1%/%2%, but \"%3%\" is shard %4%/%5%")
+                                               % (i + 1) % shards.size() % output_file % manifest.shard.index
+                                               % manifest.shard.count;
+            throw std::invalid_argument(message.str());
+        }
+
+        if (manifest.input_file_size != first.input_file_size || manifest.input_file_time != first.input_file_time ||
+            manifest.unit != first.unit || manifest.input_size != first.input_size)
+        {
+            const auto message = boost::format("shard \"%1%\" is of another input than shard \"%2%\"")
+                                               % output_file % shards.front().second;
+            throw std::invalid_argument(message.str());
+        }
+
+        const auto expected_begin = i == 0 ? 0 : shards[i - 1].first.end;
+        if (manifest.begin != expected_begin || manifest.end < manifest.begin ||
+            (i + 1 == shards.size() && manifest.end != manifest.input_size))
+        {
+            const auto message = boost::format("shard \"%1%\" covers %2% to %3%, but was expected to begin at %4%")
+                                               % output_file % manifest.begin % manifest.end % expected_begin;
+            throw std::invalid_argument(message.str());
+        }
+
+        uint64_t output_size;
+        if (hash_file(output_file, output_size) != manifest.output_checksum || output_size != manifest.output_size)
+        {
+            const auto message = boost::format("the output \"%1%\" does not match its manifest") % output_file;
+            throw std::invalid_argument(message.str());
+        }
+    }
+
+    std::vector<char> buffer(1 << 16);
+
+    for (const auto &[manifest, output_file] : shards)
+    {
+        std::ifstream file(output_file, std::ios::binary);
+        while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+            output.write(buffer.data(), file.gcount());
+    }
+
+    output.flush();
+}
+
+/*
+ * Restores the original buffer of a redirected stream when going out of scope.
+ */
+struct stream_redirection_t
+{
+    std::ostream &stream;
+    std::streambuf *buffer;
+
+    ~stream_redirection_t()
+    {
+        stream.rdbuf(buffer);
+    }
+};
+
+struct aggregations_t
+{
+    bool sum = false;
+    bool min = false;
+    bool max = false;
+    bool count = false;
+    bool histogram = false;
+};
+
+/*
+ * Aggregates the values of all inputs in parallel, each job into its own partial aggregate, and writes the requested
+ * aggregations as numbers and numerals.
+ * \returns the number of inputs that could not be aggregated.
+ */
+std::size_t aggregate_inputs(const std::vector<std::string_view> &inputs, const aggregations_t &aggregations,
+                             num::converter_c &converter, const std::size_t jobs_count, const bool use_colors)
+{
+    const auto threads_count = std::max<std::size_t>(1, std::min<std::size_t>(inputs.size() / 100, jobs_count));
+    std::vector<num::value_aggregate_c> aggregates(threads_count);
+    std::vector<std::vector<std::pair<std::size_t, std::string>>> failures(threads_count);
+    std::vector<std::thread> threads;
+
+    const auto aggregate = [&](const std::size_t start_index) {
+        for (auto i = start_index; i < inputs.size(); i += threads_count)
+        {
+            try
+            {
+                converter.accumulate(inputs[i], aggregates[start_index]);
+            }
+            catch (const std::exception &ex)
+            {
+                failures[start_index].emplace_back(i, ex.what());
+            }
+        }
+    };
+
+    for (std::size_t i = 1; i < threads_count; i++)
+        threads.emplace_back(aggregate, i);
+
+    aggregate(0);
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (std::size_t i = 1; i < threads_count; i++)
+        aggregates[0].merge(aggregates[i]);
+
+    std::size_t failure_count = 0;
+    for (const auto &thread_failures : failures)
+    {
+        for (const auto &[i, message] : thread_failures)
+            std::cerr << (use_colors ? "\033[31m" : "") << boost::format("Error: \"%1%\": %2%") % inputs[i] % message
+                      << (use_colors ? "\033[0m\n" : "\n");
+        failure_count += thread_failures.size();
+    }
+
+    const auto &result = aggregates[0];
+    const auto decimal_separator_symbol = converter.conversion_options().decimal_separator_symbol;
+
+    const auto print_value = [&](const char *name, const std::string &number) {
+        std::cout << name << " = " << (use_colors ? "\033[33m" : "") << number << (use_colors ? "\033[0m" : "");
+
+        try
+        {
+            std::cout << " (" << converter.to_numeral(number) << ")";
+        }
+        catch (const std::exception &)
+        {
+        }
+
+        std::cout << "\n";
+    };
+
+    if (aggregations.count)
+        std::cout << "count = " << (use_colors ? "\033[33m" : "") << result.count()
+                  << (use_colors ? "\033[0m\n" : "\n");
+
+    if (aggregations.sum)
+        print_value("sum", result.sum(decimal_separator_symbol));
+
+    if (aggregations.min && result.count() > 0)
+        print_value("min", result.min(decimal_separator_symbol));
+
+    if (aggregations.max && result.count() > 0)
+        print_value("max", result.max(decimal_separator_symbol));
+
+    if (aggregations.histogram)
+    {
+        std::cout << "histogram:\n";
+
+        for (const auto &[magnitude, count] : result.histogram())
+        {
+            if (magnitude.sign == 0)
+                std::cout << "  0";
+            else if (magnitude.sign > 0)
+                std::cout << boost::format("  [1e%1%, 1e%2%)") % (magnitude.exponent - 1) % magnitude.exponent;
+            else
+                std::cout << boost::format("  (-1e%1%, -1e%2%]") % magnitude.exponent % (magnitude.exponent - 1);
+
+            std::cout << ": " << count << "\n";
+        }
+    }
+
+    return failure_count;
+}
+
+/*
+ * Writes those inputs as they are whose values are within a range, both bounds included, and leaves out all others,
+ * including inputs that are neither numbers nor numerals. Inputs are compared against the bounds by their magnitudes
+ * first, so that most inputs out of range are rejected without converting them.
+ * \returns the number of inputs written.
+ */
+std::size_t filter_inputs(const std::vector<std::string_view> &inputs, const std::optional<num::value_digits_t> &low,
+                          const std::optional<num::value_digits_t> &high, num::converter_c &converter,
+                          const std::size_t jobs_count)
+{
+    const auto threads_count = std::max<std::size_t>(1, std::min<std::size_t>(inputs.size() / 100, jobs_count));
+    std::vector<char> matches(inputs.size());
+    std::vector<std::thread> threads;
+
+    const auto filter = [&](const std::size_t start_index) {
+        for (auto i = start_index; i < inputs.size(); i += threads_count)
+        {
+            const auto &input = inputs[i];
+
+            try
+            {
+                matches[i] = (!low || converter.compare_values(input, *low) >= 0) &&
+                             (!high || converter.compare_values(input, *high) <= 0) &&
+                             (converter.is_number(input) || converter.is_numeral(input));
+            }
+            catch (const std::exception &)
+            {
+                matches[i] = false;
+            }
+        }
+    };
+
+    for (std::size_t i = 1; i < threads_count; i++)
+        threads.emplace_back(filter, i);
+
+    filter(0);
+
+    for (auto &thread : threads)
+        thread.join();
+
+    std::size_t matches_count = 0;
+    for (std::size_t i = 0; i < inputs.size(); i++)
+    {
+        if (matches[i])
+        {
+            std::cout << inputs[i] << "\n";
+            matches_count++;
+        }
+    }
+
+    return matches_count;
+}
+
 void process_program_options(const boost::program_options::variables_map &vm,
                              num::conversion_options_t &conversion_options)
 {
@@ -106,17 +722,27 @@ void process_program_options(const boost::program_options::variables_map &vm,
         else if (naming_system == "long-scale" || naming_system == "long" ||
             naming_system == "ls" || naming_system == "LS")
             conversion_options.naming_system = num::naming_system_t::long_scale;
+        else if (naming_system == "indian" || naming_system == "in" || naming_system == "IN")
+            conversion_options.naming_system = num::naming_system_t::indian;
+        else if (naming_system == "myriad" || naming_system == "my" || naming_system == "MY")
+            conversion_options.naming_system = num::naming_system_t::myriad;
         else
         {
             const auto message = boost::format("\"%1%\" is not a valid number naming system. "
-                                               "Supported naming systems are 'short-scale' and 'long-scale'.")
+                                               "Supported naming systems are 'short-scale', 'long-scale', 'indian' "
+                                               "and 'myriad'.")
                                                % naming_system;
             throw std::logic_error(message.str());
         }
     }
     
     if (vm.count("language"))
-        conversion_options.language = vm["language"].as<std::string>();
+    {
+        // The conversion options only reference the language, so it has to outlive the variables map.
+        static std::string language;
+        language = vm["language"].as<std::string>();
+        conversion_options.language = language;
+    }
     
     if (vm.count("use-scientific-notation"))
         conversion_options.use_scientific_notation = vm["use-scientific-notation"].as<bool>();
@@ -127,6 +753,9 @@ void process_program_options(const boost::program_options::variables_map &vm,
     if (vm.count("force-leading-zero"))
         conversion_options.force_leading_zero = vm["force-leading-zero"].as<bool>();
     
+    if (vm.count("max-term-edits"))
+        conversion_options.max_term_edits = vm["max-term-edits"].as<uint32_t>();
+
     if (vm.count("thousands-separator-symbol"))
     {
         conversion_options.thousands_separator_symbol = vm["thousands-separator-symbol"].as<char>();
@@ -154,12 +783,23 @@ int main(int argc, const char** argv)
           "Help and usage information" )
         ( "input,i", value<std::vector<std::string>>()->multitoken(),
           "Input value (either number or numeral)" )
+        ( "input-file,f", value<std::string>(),
+          "File with one input per line, of which empty lines are skipped, or binary corpus file generated by "
+          "numero_generator" )
+        ( "output-file,O", value<std::string>(),
+          "File to write the output to instead of the standard output" )
+        ( "shard", value<std::string>(),
+          "Converts only the i-th of N shards of the input file, given as 'i/N' and counting from 1; shards are byte "
+          "ranges aligned to lines, or ranges of inputs of a binary corpus. With '--output-file', a manifest is "
+          "written next to the output. Not available for records and running text" )
+        ( "merge-shards", bool_switch(),
+          "Verifies the shard outputs given as inputs against their manifests and writes them in shard order" )
         ( "jobs-count,j", value<std::size_t>(),
           "Maximum number of parallel jobs for conversion" )
         ( "output-mode,o", value<std::string>(),
           "Either 'descriptive', 'associative' or 'bare'" )
         ( "naming-system,s", value<std::string>()->default_value("short-scale"),
-          "Number naming system; either 'short-scale' ('SS') or 'long-scale' ('LS')" )
+          "Number naming system; either 'short-scale' ('SS'), 'long-scale' ('LS'), 'indian' ('IN') or 'myriad' ('MY')" )
         ( "language,l", value<std::string>()->default_value("en-us"),
           "ISO 639-1 standard language code for conversion to numerals" )
         ( "use-scientific-notation", value<bool>()->default_value(false),
@@ -172,6 +812,36 @@ int main(int argc, const char** argv)
           "Thousands separator symbol" )
         ( "decimal-separator-symbol,D", value<char>(),
           "Decimal separator symbol" )
+        ( "max-term-edits,e", value<uint32_t>()->default_value(0),
+          "Maximum number of edits by which unknown terms of numerals are corrected to terms of the lexicon, e.g. "
+          "misspellings in OCR or ASR output; 0 does not correct any terms" )
+        ( "cache-file", value<std::string>(),
+          "Memory-mapped file in which conversion results are cached across runs; created if it does not exist or "
+          "if it was created with another lexicon" )
+        ( "shadow-sample-rate", value<double>(),
+          "Fraction of conversions between 0 and 1 that are validated against the reference engine in the background; "
+          "mismatches are reported" )
+        ( "scan-text", bool_switch(),
+          "Replaces all numerals in the running text of the input file or of the standard input by numbers and writes "
+          "the text to the standard output" )
+        ( "csv", bool_switch(),
+          "Converts the selected columns of CSV records of the input file or of the standard input and writes the records "
+          "to the standard output; fields are quoted according to RFC 4180" )
+        ( "tsv", bool_switch(),
+          "Converts the selected columns of tab separated records like '--csv', but without quoting" )
+        ( "columns,c", value<std::string>(),
+          "Comma separated list of the columns to be converted in '--csv' or '--tsv' mode, counting from 1" )
+        ( "header", bool_switch(),
+          "Copies the first record in '--csv' or '--tsv' mode as it is" )
+        ( "aggregate,a", value<std::string>(),
+          "Comma separated list of aggregations of the values of all inputs instead of converting them; any of 'sum', "
+          "'min', 'max', 'count' and 'histogram' (of orders of magnitude)" )
+        ( "filter-range", value<std::string>(),
+          "Writes only those inputs as they are whose values are within the range 'LOW:HIGH', both bounds included, "
+          "instead of converting them; either bound may be left out" )
+        ( "verbalize-text", bool_switch(),
+          "Replaces all numbers in the running text of the input file or of the standard input by numerals and writes "
+          "the text to the standard output" )
         ( "no-colors", bool_switch(),
           "Does not use text color escape characters; useful when redirecting output to files" );
         
@@ -190,9 +860,26 @@ int main(int argc, const char** argv)
     };
 
     std::vector<std::string> cmdline_inputs, stdin_inputs;
+    std::string input_file;
+    std::string output_file;
+    shard_t shard;
+    shard_manifest_t shard_manifest;
+    bool merge_shards_mode = false;
+    std::string cache_file;
+    aggregations_t aggregations;
+    bool aggregate = false;
+    std::optional<std::string> filter_range;
+    std::unique_ptr<num::corpus_c> corpus;
     output_mode_t output_mode = output_mode_t::unset;
     timing_mode_t timing_mode = timing_mode_t::dont_time;
     std::size_t jobs_count = 1;
+    double shadow_sample_rate = 0.0;
+    bool scan_text = false;
+    bool verbalize_text = false;
+    bool csv = false;
+    bool tsv = false;
+    bool header = false;
+    std::vector<std::size_t> columns;
     bool use_colors = true;
     
     positional_options_description positional_program_options;
@@ -255,11 +942,133 @@ int main(int argc, const char** argv)
 
         if (vm.count("input"))
             cmdline_inputs = vm["input"].as<std::vector<std::string>>();
+
+        if (vm.count("input-file"))
+            input_file = vm["input-file"].as<std::string>();
         
+        if (vm.count("output-file"))
+            output_file = vm["output-file"].as<std::string>();
+
+        if (vm.count("shard"))
+        {
+            const auto &shard_string = vm["shard"].as<std::string>();
+            const auto slash = shard_string.find('/');
+            const auto parse = [&](const std::size_t begin, const std::size_t end, std::size_t &value) {
+                const auto [last, error] = std::from_chars(shard_string.data() + begin, shard_string.data() + end,
+                                                           value);
+                return error == std::errc() && last == shard_string.data() + end;
+            };
+
+            if (slash == std::string::npos || !parse(0, slash, shard.index) ||
+                !parse(slash + 1, shard_string.size(), shard.count) || shard.index == 0 || shard.index > shard.count)
+            {
+                const auto message = boost::format("\"%1%\" is not a valid shard; expected 'i/N' with i from 1 to N")
+                                                   % shard_string;
+                throw std::invalid_argument(message.str());
+            }
+
+            if (input_file.empty())
+                throw std::invalid_argument("'--shard' requires an input file");
+        }
+
+        if (vm.count("aggregate"))
+        {
+            const auto &aggregations_string = vm["aggregate"].as<std::string>();
+
+            for (std::size_t begin = 0, end; begin <= aggregations_string.size(); begin = end + 1)
+            {
+                end = std::min(aggregations_string.find(',', begin), aggregations_string.size());
+                const auto aggregation = std::string_view(aggregations_string).substr(begin, end - begin);
+
+                if (aggregation == "sum")
+                    aggregations.sum = true;
+                else if (aggregation == "min")
+                    aggregations.min = true;
+                else if (aggregation == "max")
+                    aggregations.max = true;
+                else if (aggregation == "count")
+                    aggregations.count = true;
+                else if (aggregation == "histogram")
+                    aggregations.histogram = true;
+                else
+                {
+                    const auto message = boost::format("\"%1%\" is not a valid aggregation. Supported aggregations "
+                                                       "are 'sum', 'min', 'max', 'count' and 'histogram'.")
+                                                       % aggregation;
+                    throw std::invalid_argument(message.str());
+                }
+            }
+
+            aggregate = true;
+        }
+
+        if (vm.count("filter-range"))
+            filter_range = vm["filter-range"].as<std::string>();
+
+        if (vm.count("merge-shards"))
+            merge_shards_mode = vm["merge-shards"].as<bool>();
+
+        if (merge_shards_mode && cmdline_inputs.empty())
+            throw std::invalid_argument("'--merge-shards' requires the shard outputs as inputs");
+
         if (vm.count("jobs-count"))
             jobs_count = std::clamp<std::size_t>(vm["jobs-count"].as<std::size_t>(),
                                                  1, std::thread::hardware_concurrency());
 
+        if (vm.count("cache-file"))
+            cache_file = vm["cache-file"].as<std::string>();
+
+        if (vm.count("shadow-sample-rate"))
+        {
+            shadow_sample_rate = vm["shadow-sample-rate"].as<double>();
+            if (shadow_sample_rate < 0.0 || shadow_sample_rate > 1.0)
+                throw std::invalid_argument("'shadow-sample-rate' must be between '0' and '1'");
+        }
+
+        if (vm.count("scan-text"))
+            scan_text = vm["scan-text"].as<bool>();
+
+        if (vm.count("verbalize-text"))
+            verbalize_text = vm["verbalize-text"].as<bool>();
+
+        if (vm.count("csv"))
+            csv = vm["csv"].as<bool>();
+
+        if (vm.count("tsv"))
+            tsv = vm["tsv"].as<bool>();
+
+        if (vm.count("header"))
+            header = vm["header"].as<bool>();
+
+        if (vm.count("columns"))
+        {
+            const auto &columns_string = vm["columns"].as<std::string>();
+            std::size_t begin = 0;
+
+            for (std::size_t end; begin <= columns_string.size(); begin = end + 1)
+            {
+                end = std::min(columns_string.find(',', begin), columns_string.size());
+                std::size_t column = 0;
+                const auto [last, error] = std::from_chars(columns_string.data() + begin,
+                                                           columns_string.data() + end, column);
+
+                if (error != std::errc() || last != columns_string.data() + end || column == 0)
+                {
+                    const auto message = boost::format("\"%1%\" is not a valid list of columns") % columns_string;
+                    throw std::invalid_argument(message.str());
+                }
+
+                columns.push_back(column);
+            }
+        }
+
+        if ((csv || tsv) && columns.empty())
+            throw std::invalid_argument("'--csv' and '--tsv' require the columns to be converted");
+
+        if (shard.count > 0 && (csv || tsv || scan_text || verbalize_text))
+            throw std::invalid_argument("'--shard' cannot be used with '--csv', '--tsv', '--scan-text' or "
+                                        "'--verbalize-text'");
+
         if (vm.count("no-colors"))
             use_colors = !vm["no-colors"].as<bool>();
         
@@ -271,25 +1080,256 @@ int main(int argc, const char** argv)
         return EXIT_FAILURE;
     }
 
-    if (cmdline_inputs.empty())
+    // All output goes to the output file instead of the standard output, if there is one.
+    std::ofstream output_stream;
+    stream_redirection_t output_redirection { std::cout, std::cout.rdbuf() };
+
+    if (!output_file.empty())
     {
-        for (std::string line; std::getline(std::cin, line);)
+        output_stream.open(output_file, std::ios::binary);
+        if (!output_stream)
         {
-            if (line == "") break;
-            stdin_inputs.push_back(line);
+            std::cerr << "\033[31mError: " << boost::format("unable to open output file \"%1%\"") % output_file
+                      << "\033[0m\n\n";
+            return EXIT_FAILURE;
         }
+
+        std::cout.rdbuf(output_stream.rdbuf());
+        use_colors = false;
     }
 
+    if (merge_shards_mode)
+    {
+        try
+        {
+            merge_shards(cmdline_inputs, std::cout);
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // Running text is scanned in chunks and written as it is scanned, so that texts of any size can be processed.
+    if (scan_text || verbalize_text)
+    {
+        try
+        {
+            std::ifstream file;
+            if (!input_file.empty())
+            {
+                file.open(input_file, std::ios::binary);
+                if (!file)
+                {
+                    const auto message = boost::format("unable to open input file \"%1%\"") % input_file;
+                    throw std::invalid_argument(message.str());
+                }
+            }
+
+            auto &stream = input_file.empty() ? std::cin : file;
+            const auto write = [](const std::string_view &output) { std::cout << output; };
+            num::text_scanner_c text_scanner(conversion_options, write);
+            num::text_verbalizer_c text_verbalizer(conversion_options, write);
+
+            std::vector<char> chunk(1 << 16);
+            while (stream.read(chunk.data(), chunk.size()) || stream.gcount() > 0)
+            {
+                const auto text = std::string_view(chunk.data(), static_cast<std::size_t>(stream.gcount()));
+                if (scan_text)
+                    text_scanner.push(text);
+                else
+                    text_verbalizer.push(text);
+            }
+
+            if (scan_text)
+                text_scanner.finish();
+            else
+                text_verbalizer.finish();
+            std::cout.flush();
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // Records are converted in blocks and written as they are converted, so that files of any size can be processed.
+    if (csv || tsv)
+    {
+        try
+        {
+            std::ifstream file;
+            if (!input_file.empty())
+            {
+                file.open(input_file, std::ios::binary);
+                if (!file)
+                {
+                    const auto message = boost::format("unable to open input file \"%1%\"") % input_file;
+                    throw std::invalid_argument(message.str());
+                }
+            }
+
+            num::converter_c converter(conversion_options);
+            if (!cache_file.empty())
+                converter.enable_result_cache(std::make_shared<num::result_cache_c>(cache_file));
+
+            const auto failure_count = convert_records(input_file.empty() ? std::cin : file, std::cout, columns,
+                                                       csv ? ',' : '\t', csv, header, converter, jobs_count,
+                                                       use_colors);
+            return failure_count ? static_cast<int>(std::min<std::size_t>(failure_count, 255)) : EXIT_SUCCESS;
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::string_view> inputs;
+
+    try
+    {
+        // Binary corpora are mapped into memory and their inputs are used in place.
+        if (!input_file.empty() && num::corpus_c::is_corpus(input_file))
+        {
+            corpus = std::make_unique<num::corpus_c>(input_file);
+
+            if (shard.count > 0)
+            {
+                shard_manifest.unit = "inputs";
+                shard_manifest.input_size = corpus->size();
+                shard_manifest.begin = corpus->size() * (shard.index - 1) / shard.count;
+                shard_manifest.end = corpus->size() * shard.index / shard.count;
+                inputs.assign(corpus->begin() + shard_manifest.begin, corpus->begin() + shard_manifest.end);
+
+                stat_input_file(input_file, shard_manifest);
+                shard_manifest.range_checksum = fnv_offset_basis;
+                for (const auto &input : inputs)
+                    shard_manifest.range_checksum = hash_bytes("\n", hash_bytes(input, shard_manifest.range_checksum));
+            }
+            else
+                inputs.assign(corpus->begin(), corpus->end());
+        }
+        else if (!input_file.empty())
+        {
+            std::ifstream file(input_file, std::ios::binary);
+            if (!file)
+            {
+                const auto message = boost::format("unable to open input file \"%1%\"") % input_file;
+                throw std::invalid_argument(message.str());
+            }
+
+            // Empty lines of input files are skipped rather than ending the input, so that the outputs of all shards
+            // make up the output of the whole file. A shard is read as a whole.
+            if (shard.count > 0)
+            {
+                file.seekg(0, std::ios::end);
+                const auto size = static_cast<uint64_t>(file.tellg());
+
+                shard_manifest.unit = "bytes";
+                shard_manifest.input_size = size;
+                shard_manifest.begin = align_to_line(file, size * (shard.index - 1) / shard.count, size);
+                shard_manifest.end = align_to_line(file, size * shard.index / shard.count, size);
+
+                std::string range(shard_manifest.end - shard_manifest.begin, '\0');
+                file.clear();
+                file.seekg(static_cast<std::streamoff>(shard_manifest.begin));
+                file.read(range.data(), static_cast<std::streamsize>(range.size()));
+
+                stat_input_file(input_file, shard_manifest);
+                shard_manifest.range_checksum = hash_bytes(range, fnv_offset_basis);
+
+                std::istringstream lines(range);
+                for (std::string line; std::getline(lines, line);)
+                {
+                    if (!line.empty())
+                        stdin_inputs.push_back(line);
+                }
+            }
+            else
+            {
+                for (std::string line; std::getline(file, line);)
+                {
+                    if (!line.empty())
+                        stdin_inputs.push_back(line);
+                }
+            }
+        }
+        else if (cmdline_inputs.empty())
+        {
+            for (std::string line; std::getline(std::cin, line);)
+            {
+                if (line == "") break;
+                stdin_inputs.push_back(line);
+            }
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto inputs_from_cmdline = !corpus && stdin_inputs.empty() && shard.count == 0;
+
+    if (!corpus)
+        inputs.assign(inputs_from_cmdline ? cmdline_inputs.begin() : stdin_inputs.begin(),
+                      inputs_from_cmdline ? cmdline_inputs.end() : stdin_inputs.end());
+
     if (output_mode == output_mode_t::unset)
-        output_mode = stdin_inputs.empty() ? output_mode_t::descriptive : output_mode_t::associative;
+        output_mode = inputs_from_cmdline ? output_mode_t::descriptive : output_mode_t::associative;
 
-    if (cmdline_inputs.empty() && stdin_inputs.empty())
+    if (inputs.empty() && shard.count == 0)
     {
         print_usage_information();
         return EXIT_FAILURE;
     }
 
-    const auto &inputs = !stdin_inputs.empty() ? stdin_inputs : cmdline_inputs;
+    if (filter_range)
+    {
+        num::converter_c converter(conversion_options);
+        std::optional<num::value_digits_t> low, high;
+
+        try
+        {
+            const auto colon = filter_range->find(':');
+            if (colon == std::string::npos)
+            {
+                const auto message = boost::format("\"%1%\" is not a valid range; expected 'LOW:HIGH'") % *filter_range;
+                throw std::invalid_argument(message.str());
+            }
+
+            const auto low_string = filter_range->substr(0, colon);
+            const auto high_string = filter_range->substr(colon + 1);
+
+            if (!low_string.empty())
+                low = converter.significant_digits(low_string);
+            if (!high_string.empty())
+                high = converter.significant_digits(high_string);
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+            return EXIT_FAILURE;
+        }
+
+        filter_inputs(inputs, low, high, converter, jobs_count);
+        return EXIT_SUCCESS;
+    }
+
+    if (aggregate)
+    {
+        num::converter_c converter(conversion_options);
+        const auto failure_count = aggregate_inputs(inputs, aggregations, converter, jobs_count, use_colors);
+        return failure_count ? static_cast<int>(std::min<std::size_t>(failure_count, 255)) : EXIT_SUCCESS;
+    }
+
     const auto threads_count = std::max<std::size_t>(1, std::min<std::size_t>(inputs.size() / 10, jobs_count));
     
     std::vector<conversion_t> conversions(inputs.size());
@@ -306,12 +1346,40 @@ int main(int argc, const char** argv)
     case num::naming_system_t::long_scale:
         naming_system_string = "long scale";
         break;
+    case num::naming_system_t::indian:
+        naming_system_string = "Indian system";
+        break;
+    case num::naming_system_t::myriad:
+        naming_system_string = "myriad system";
+        break;
     default:
         naming_system_string = "undefined scale";
     }
 
     num::converter_c converter(conversion_options);
     std::chrono::system_clock::time_point before_convert, after_convert;
+
+    if (!cache_file.empty())
+    {
+        try
+        {
+            converter.enable_result_cache(std::make_shared<num::result_cache_c>(cache_file));
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (shadow_sample_rate > 0.0)
+        converter.enable_shadow_mode(shadow_sample_rate, [use_colors](const num::shadow_mismatch_t &mismatch) {
+            std::cerr << (use_colors ? "\033[31m" : "")
+                      << boost::format("Shadow mismatch in %1%(\"%2%\"): \"%3%\" but reference engine gives \"%4%\"")
+                                       % mismatch.operation % mismatch.input % mismatch.result
+                                       % mismatch.reference_result
+                      << (use_colors ? "\033[0m\n" : "\n");
+        });
         
     if (timing_mode != timing_mode_t::time_all_durations || timing_mode != timing_mode_t::time_total_duration)
         before_convert = hr_clock::now();
@@ -388,7 +1456,20 @@ int main(int argc, const char** argv)
             total_failure_count++;
     }
 
-    if (timing_mode == timing_mode_t::time_total_duration || timing_mode == timing_mode_t::time_all_durations)
+    if (shadow_sample_rate > 0.0)
+    {
+        converter.flush_shadow_mode();
+
+        const auto statistics = converter.shadow_statistics();
+        std::cerr << boost::format("Shadow mode compared %1% of %2% sampled conversions (%3% dropped) and found %4% "
+                                   "mismatches\n") % statistics.compared % statistics.sampled % statistics.dropped
+                                   % statistics.mismatches;
+
+        total_failure_count += statistics.mismatches;
+    }
+
+    if ((timing_mode == timing_mode_t::time_total_duration || timing_mode == timing_mode_t::time_all_durations) &&
+        !inputs.empty())
     {
         int64_t average_time = total_time / inputs.size();
         std::cout << "   - took " << total_time << " us in absolute total (" << average_time << " us on average)\n";
@@ -402,6 +1483,23 @@ int main(int argc, const char** argv)
                       << " us on average) using " << threads_count << " jobs\n";
         }
     }
+
+    if (shard.count > 0 && !output_file.empty())
+    {
+        try
+        {
+            std::cout.flush();
+            shard_manifest.shard = shard;
+            shard_manifest.input_file = input_file;
+            shard_manifest.output_checksum = hash_file(output_file, shard_manifest.output_size);
+            write_shard_manifest(output_file + ".manifest", shard_manifest);
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+            return EXIT_FAILURE;
+        }
+    }
     
     return total_failure_count ? total_failure_count : EXIT_SUCCESS;
 }
@@ -0,0 +1,269 @@
+#ifndef NUMERO_GENERATOR_ADVERSARIAL_H
+#define NUMERO_GENERATOR_ADVERSARIAL_H
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "random.h"
+
+/*
+ * Kinds of invalid or tricky inputs. Apart from some degenerate inputs, each of them is rejected by the converter for
+ * a different reason, so that all of its error paths can be exercised.
+ */
+enum class invalid_kind_t
+{
+    misordered_magnitudes = 0,
+    duplicate_magnitudes,
+    unknown_words,
+    illiard_in_short_scale,
+    overlapping_places,
+    huge_exponents,
+    malformed_separators,
+    degenerate,
+    count
+};
+
+static constexpr std::array<std::string_view, static_cast<std::size_t>(invalid_kind_t::count)> invalid_kind_names = {
+    "misordered-magnitudes",
+    "duplicate-magnitudes",
+    "unknown-words",
+    "illiard-in-short-scale",
+    "overlapping-places",
+    "huge-exponents",
+    "malformed-separators",
+    "degenerate"
+};
+
+/*
+ * Parses a comma separated list of invalid kinds with optional weights, e.g. "unknown-words:3,huge-exponents". The
+ * special kind "all" selects all kinds with the same weight.
+ */
+inline std::vector<std::pair<invalid_kind_t, double>> parse_invalid_kinds(const std::string &list)
+{
+    std::vector<std::pair<invalid_kind_t, double>> kinds;
+
+    for (std::size_t begin = 0; begin <= list.size();)
+    {
+        auto end = list.find(',', begin);
+        if (end == std::string::npos)
+            end = list.size();
+
+        const auto entry = std::string_view(list).substr(begin, end - begin);
+        const auto colon = entry.find(':');
+        const auto name = entry.substr(0, colon);
+        const auto weight = colon == std::string_view::npos ? 1.0 : std::stod(std::string(entry.substr(colon + 1)));
+
+        if (weight < 0.0)
+            throw std::invalid_argument((boost::format("the weight of \"%1%\" must not be negative") % name).str());
+
+        if (name == "all")
+        {
+            for (std::size_t kind = 0; kind < invalid_kind_names.size(); kind++)
+                kinds.emplace_back(static_cast<invalid_kind_t>(kind), weight);
+        }
+        else
+        {
+            std::size_t kind = 0;
+            while (kind < invalid_kind_names.size() && invalid_kind_names[kind] != name)
+                kind++;
+
+            if (kind == invalid_kind_names.size())
+                throw std::invalid_argument((boost::format("\"%1%\" is not a valid invalid input kind") % name).str());
+
+            kinds.emplace_back(static_cast<invalid_kind_t>(kind), weight);
+        }
+
+        begin = end + 1;
+    }
+
+    return kinds;
+}
+
+/*
+ * Generates invalid or tricky inputs of the given kinds in proportion to their weights. Lines are not terminated.
+ */
+class invalid_line_generator_c
+{
+public:
+    explicit invalid_line_generator_c(const std::vector<std::pair<invalid_kind_t, double>> &kinds)
+    {
+        double total_weight = 0.0;
+        for (const auto &[kind, weight] : kinds)
+            total_weight += weight;
+
+        if (total_weight <= 0.0)
+            throw std::invalid_argument("at least one invalid input kind must have a weight greater than zero");
+
+        double cumulative_weight = 0.0;
+        for (const auto &[kind, weight] : kinds)
+        {
+            cumulative_weight += weight;
+            _kinds.emplace_back(kind, cumulative_weight / total_weight);
+        }
+    }
+
+    template <class Rng>
+    void append_line(Rng &rng, std::string &buffer) const
+    {
+        const auto random = uniform_real(rng);
+        auto kind = _kinds.back().first;
+
+        for (const auto &[candidate, cumulative_probability] : _kinds)
+        {
+            if (random < cumulative_probability)
+            {
+                kind = candidate;
+                break;
+            }
+        }
+
+        switch (kind)
+        {
+        case invalid_kind_t::misordered_magnitudes:
+        {
+            // A lower magnitude sub numeral followed by a higher one, e.g. "two thousand five million".
+            const auto lower = uniform_random(rng, 0, scales.size() - 2);
+            const auto higher = uniform_random(rng, lower + 1, scales.size() - 1);
+            append_sub_numeral(rng, lower, buffer);
+            buffer += ' ';
+            append_sub_numeral(rng, higher, buffer);
+            break;
+        }
+        case invalid_kind_t::duplicate_magnitudes:
+        {
+            // Two sub numerals of the same magnitude, e.g. "two million five million".
+            const auto scale = uniform_random(rng, 0, scales.size() - 1);
+            append_sub_numeral(rng, scale, buffer);
+            buffer += ' ';
+            append_sub_numeral(rng, scale, buffer);
+            break;
+        }
+        case invalid_kind_t::unknown_words:
+        {
+            // A valid looking numeral with a misspelled or made up term somewhere in it.
+            const auto position = uniform_random(rng, 0, 2);
+            for (uint64_t i = 0; i < 3; i++)
+            {
+                if (i > 0)
+                    buffer += ' ';
+
+                if (i == position)
+                    buffer += pick(rng, unknown_words);
+                else if (i == 1)
+                    buffer += "hundred";
+                else
+                    buffer += pick(rng, units);
+            }
+            break;
+        }
+        case invalid_kind_t::illiard_in_short_scale:
+        {
+            buffer += pick(rng, units);
+            buffer += ' ';
+            buffer += pick(rng, illiards);
+            break;
+        }
+        case invalid_kind_t::overlapping_places:
+        {
+            // Additive terms that occupy the same places, e.g. "twenty twelve" or "four hundred three sixty".
+            if (bernoulli(rng, 0.5))
+            {
+                buffer += pick(rng, tens);
+                buffer += ' ';
+                buffer += pick(rng, teens);
+            }
+            else
+            {
+                buffer += pick(rng, units);
+                buffer += " hundred ";
+                buffer += pick(rng, units);
+                buffer += ' ';
+                buffer += pick(rng, tens);
+            }
+            break;
+        }
+        case invalid_kind_t::huge_exponents:
+        {
+            buffer += pick(rng, units_digits);
+            buffer += bernoulli(rng, 0.5) ? "e" : "e-";
+            append_random_digits(rng, static_cast<int>(uniform_random(rng, 7, 24)), buffer);
+            break;
+        }
+        case invalid_kind_t::malformed_separators:
+            buffer += pick(rng, malformed_numbers);
+            break;
+        case invalid_kind_t::degenerate:
+            buffer += pick(rng, degenerate_inputs);
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    template <class Rng, std::size_t Size>
+    static std::string_view pick(Rng &rng, const std::array<std::string_view, Size> &words)
+    {
+        return words[uniform_random(rng, 0, Size - 1)];
+    }
+
+    template <class Rng>
+    static void append_sub_numeral(Rng &rng, const uint64_t scale, std::string &buffer)
+    {
+        buffer += pick(rng, units);
+        buffer += ' ';
+        buffer += scales[scale];
+    }
+
+private:
+    static constexpr std::array<std::string_view, 9> units = {
+        "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"
+    };
+
+    static constexpr std::array<std::string_view, 9> units_digits = {
+        "1", "2", "3", "4", "5", "6", "7", "8", "9"
+    };
+
+    static constexpr std::array<std::string_view, 9> teens = {
+        "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen", "seventeen", "eighteen", "nineteen"
+    };
+
+    static constexpr std::array<std::string_view, 8> tens = {
+        "twenty", "thirty", "fourty", "fifty", "sixty", "seventy", "eighty", "ninety"
+    };
+
+    static constexpr std::array<std::string_view, 6> scales = {
+        "thousand", "million", "billion", "trillion", "quadrillion", "quintillion"
+    };
+
+    static constexpr std::array<std::string_view, 5> illiards = {
+        "milliard", "billiard", "trilliard", "quadrilliard", "centilliard"
+    };
+
+    static constexpr std::array<std::string_view, 12> unknown_words = {
+        "thre", "fiv", "milion", "hundered", "tousand", "zillion", "gazillion", "eleventy", "twone", "ninty",
+        "octoillion", "x"
+    };
+
+    static constexpr std::array<std::string_view, 14> malformed_numbers = {
+        "1,00,000", "1,,000", "1,000,00", ",123", "1,000.", "1.2.3", "--5", "1e", "1e+5", "1,234.5.6", "12,34",
+        "0x1f", "1 000", "-.e5"
+    };
+
+    // Empty lines are left out as they terminate the input of numero.
+    static constexpr std::array<std::string_view, 9> degenerate_inputs = {
+        " ", "negative", "minus", "point", "-", "a", "zero hundred", "point point", "minus minus one"
+    };
+
+private:
+    std::vector<std::pair<invalid_kind_t, double>> _kinds;
+};
+
+#endif //NUMERO_GENERATOR_ADVERSARIAL_H
@@ -1,17 +1,25 @@
-#include <cassert>
-#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
-#include <iomanip>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
 
+#include <numero/corpus.h>
 #include <numero/numero.h>
 
+#include "profile.h"
+#include "random.h"
+
 enum class generation_mode_t
 {
     unset = 0,
@@ -19,23 +27,58 @@ enum class generation_mode_t
     numeral
 };
 
-template <class T>
-constexpr int num_digits(T number)
+enum class output_format_t
 {
-    int digits = 1;
-    while (number /= 10)
-        digits++;
-    return digits;
-}
+    text = 0,
+    binary
+};
 
-static inline void ltrim_zeroes(std::string &s)
+/*
+ * Generates count lines in blocks of consecutive lines. Each round, every job generates one block into its own buffer
+ * while the blocks of the previous round are written in order, so that the output does not depend on the number of
+ * jobs.
+ */
+template <class GenerateBlock, class WriteBlock>
+void generate_in_parallel(const uint64_t count, const std::size_t jobs_count, GenerateBlock &&generate_block,
+                          WriteBlock &&write_block)
 {
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) {
-        return ch != '0';
-    }));
+    constexpr uint64_t lines_per_block = 16384;
+
+    std::vector<std::string> buffers(jobs_count), written_buffers(jobs_count);
+    std::vector<std::thread> threads;
+
+    const auto write_buffers = [&](std::vector<std::string> &buffers) {
+        for (auto &buffer : buffers)
+        {
+            write_block(buffer);
+            buffer.clear();
+        }
+    };
+
+    for (uint64_t first_line = 0; first_line < count; first_line += jobs_count * lines_per_block)
+    {
+        for (std::size_t job = 0; job < jobs_count; job++)
+        {
+            const auto block_first_line = first_line + job * lines_per_block;
+            if (block_first_line >= count)
+                break;
 
-    if (s.empty())
-        s = "0";
+            const auto lines_count = std::min(lines_per_block, count - block_first_line);
+            threads.emplace_back([&, job, block_first_line, lines_count]() {
+                generate_block(job, block_first_line, lines_count, buffers[job]);
+            });
+        }
+
+        write_buffers(written_buffers);
+
+        for (auto &thread : threads)
+            thread.join();
+
+        threads.clear();
+        std::swap(buffers, written_buffers);
+    }
+
+    write_buffers(written_buffers);
 }
 
 int main(int argc, const char** argv)
@@ -43,38 +86,90 @@ int main(int argc, const char** argv)
     using namespace boost::program_options;
     using namespace num;
 
-    std::srand(time(0));
-
-    int count, min_places, max_places;
+    uint64_t count, seed;
+    profile_t profile;
+    std::size_t jobs_count = 1;
     naming_system_t naming_system = naming_system_t::undefined;
     generation_mode_t generation_mode = generation_mode_t::unset;
+    output_format_t output_format = output_format_t::text;
+    std::string output_file;
+    bool with_values = false;
 
     options_description program_options("Options");
     program_options.add_options()
         ( "help,h",
           "Help and usage information" )
-        ( "count,c", value<int>(),
+        ( "count,c", value<uint64_t>(),
           "Count of numbers or numerals to be generated" )
+        ( "seed", value<uint64_t>(),
+          "Seed of the random number generator; the same seed and options always yield the same output, regardless of "
+          "the number of jobs. A random seed is used if none is given" )
+        ( "jobs-count,j", value<std::size_t>(),
+          "Maximum number of parallel jobs for generation" )
         ( "generation-mode,g", value<std::string>()->default_value("numbers"),
           "Either 'numbers' or 'numerals'" )
         ( "naming-system,s", value<std::string>()->default_value("short-scale"),
           "Number naming system; either 'short-scale' ('SS') or 'long-scale' ('LS')" )
+        ( "output-file,o", value<std::string>(),
+          "File to write the generated lines to instead of the standard output" )
+        ( "output-format,f", value<std::string>()->default_value("text"),
+          "Either 'text' (one line per input) or 'binary' (corpus file that numero and numero_perf map into memory "
+          "without parsing; requires an output file)" )
+        ( "with-values", bool_switch(),
+          "Appends a tab and the expected value to each line, i.e. the number without thousands separators, or "
+          "nothing for invalid inputs; only supported by the 'text' output format" )
+        ( "profile,p", value<std::string>(),
+          "Profile file with 'key = value' lines of profile options; options given on the command line take "
+          "precedence" );
+
+    options_description profile_program_options("Profile Options");
+    profile_program_options.add_options()
         ( "min-places,m", value<int>()->default_value(1),
           "Minimum number of places the generated random numbers (or its equivalent numerals) shall have" )
         ( "max-places,M", value<int>()->default_value(12),
           "Maximum number of places the generated random numbers (or its equivalent numerals) shall have; this number "
           "may be as high as 303 if the 'short-scale' number system is being used, and as high as 600 if the 'long-"
-          "scale' number system is being used" );
+          "scale' number system is being used" )
+        ( "distribution", value<std::string>()->default_value("uniform-places"),
+          "Distribution of the generated numbers; either 'uniform-places' (uniformly distributed number of places), "
+          "'log-uniform' (uniformly distributed decimal logarithm) or 'zipf' (Zipf distributed values)" )
+        ( "zipf-max-value", value<uint64_t>()->default_value(1000000),
+          "Greatest value of the 'zipf' distribution" )
+        ( "zipf-exponent", value<double>()->default_value(1.1),
+          "Exponent of the 'zipf' distribution; the greater, the more frequent are small values" )
+        ( "decimal-fraction", value<double>()->default_value(0.0),
+          "Fraction of numbers that have a fractional part" )
+        ( "max-fractional-places", value<int>()->default_value(4),
+          "Maximum number of places of fractional parts" )
+        ( "negative-fraction", value<double>()->default_value(0.0),
+          "Fraction of negative numbers" )
+        ( "scientific-fraction", value<double>()->default_value(0.0),
+          "Fraction of numbers written in scientific notation" )
+        ( "separator-style", value<std::string>()->default_value("none"),
+          "Separators of numbers not written in scientific notation; either 'none', 'english' (1,234.5), 'german' "
+          "(1.234,5) or 'mixed'" )
+        ( "numeral-fraction", value<double>(),
+          "Fraction of lines written as numerals; overrides the generation mode" )
+        ( "non-canonical-fraction", value<double>()->default_value(0.0),
+          "Probability of numerals taking a valid non-canonical alternative wherever the grammar offers one, e.g. "
+          "'nineteen hundred eighteen', 'one thousand million', 'a hundred' or '300 thousand'" )
+        ( "invalid-fraction", value<double>()->default_value(0.0),
+          "Fraction of lines with invalid or tricky inputs for exercising error paths" )
+        ( "invalid-kinds", value<std::string>()->default_value("all"),
+          "Comma separated kinds of invalid inputs with optional weights, e.g. 'unknown-words:3,huge-exponents'; kinds "
+          "are 'misordered-magnitudes', 'duplicate-magnitudes', 'unknown-words', 'illiard-in-short-scale', "
+          "'overlapping-places', 'huge-exponents', 'malformed-separators', 'degenerate' and 'all'" );
         
     options_description hidden_program_options("Hidden Options");
     hidden_program_options.add_options()
         ( "debug-output", bool_switch() );
         
     options_description parsed_program_options;
-    parsed_program_options.add(program_options).add(hidden_program_options);
+    parsed_program_options.add(program_options).add(profile_program_options).add(hidden_program_options);
         
     const auto print_usage_information = [&]() {
-        std::cout << "Usage:\n  numero_generator [options]\n\n" << program_options << "\n";
+        std::cout << "Usage:\n  numero_generator [options]\n\n" << program_options << "\n"
+                  << profile_program_options << "\n";
         return EXIT_FAILURE;
     };
     
@@ -86,8 +181,29 @@ int main(int argc, const char** argv)
         
         variables_map vm;
         store(parsed_options, vm);
+
+        if (vm.count("profile"))
+        {
+            const auto &profile_path = vm["profile"].as<std::string>();
+            std::ifstream profile_file(profile_path);
+            if (!profile_file)
+            {
+                const auto message = boost::format("unable to open profile file \"%1%\"") % profile_path;
+                throw std::invalid_argument(message.str());
+            }
+
+            store(parse_config_file(profile_file, profile_program_options), vm);
+        }
+
         notify(vm);
 
+        const auto fraction = [&](const char *name) {
+            const auto value = vm[name].as<double>();
+            if (value < 0.0 || value > 1.0)
+                throw std::invalid_argument((boost::format("'%1%' must be between '0' and '1'") % name).str());
+            return value;
+        };
+
         if (vm.count("help"))
         {
             print_usage_information();
@@ -96,13 +212,22 @@ int main(int argc, const char** argv)
 
         if (vm.count("count"))
         {
-            count = vm["count"].as<int>();
+            count = vm["count"].as<uint64_t>();
             if (count < 1)
-                throw std::invalid_argument("count must not be zero or less");
+                throw std::invalid_argument("count must not be zero");
         }
         else
             throw std::invalid_argument("the option '--count' is required but missing");
 
+        if (vm.count("seed"))
+            seed = vm["seed"].as<uint64_t>();
+        else
+            seed = (static_cast<uint64_t>(std::random_device()()) << 32) | std::random_device()();
+
+        if (vm.count("jobs-count"))
+            jobs_count = std::clamp<std::size_t>(vm["jobs-count"].as<std::size_t>(),
+                                                 1, std::thread::hardware_concurrency());
+
         if (vm.count("generation-mode"))
         {
             const auto &generation_mode_string = vm["generation-mode"].as<std::string>();
@@ -119,6 +244,32 @@ int main(int argc, const char** argv)
             }
         }
 
+        if (vm.count("output-file"))
+            output_file = vm["output-file"].as<std::string>();
+
+        if (vm.count("output-format"))
+        {
+            const auto &output_format_string = vm["output-format"].as<std::string>();
+            if (output_format_string == "text")
+                output_format = output_format_t::text;
+            else if (output_format_string == "binary")
+                output_format = output_format_t::binary;
+            else
+            {
+                const auto message = boost::format("\"%1%\" is not a valid output format. "
+                                                   "Supported output formats are 'text' and 'binary'.")
+                                                   % output_format_string;
+                throw std::invalid_argument(message.str());
+            }
+
+            if (output_format == output_format_t::binary && output_file.empty())
+                throw std::invalid_argument("the 'binary' output format requires an '--output-file'");
+        }
+
+        with_values = vm["with-values"].as<bool>();
+        if (with_values && output_format != output_format_t::text)
+            throw std::invalid_argument("'--with-values' is only supported by the 'text' output format");
+
         if (vm.count("naming-system"))
         {
             const auto &naming_system_string = vm["naming-system"].as<std::string>();
@@ -139,18 +290,84 @@ int main(int argc, const char** argv)
 
         if (vm.count("min-places"))
         {
-            min_places = vm["min-places"].as<int>();
-            if (min_places < 1)
+            profile.min_places = vm["min-places"].as<int>();
+            if (profile.min_places < 1)
                 throw std::invalid_argument("'min-places' must at least be '1'");
         }
 
         if (vm.count("max-places"))
         {
-            max_places = vm["max-places"].as<int>();
-            if (max_places > 303 && naming_system == naming_system_t::short_scale)
+            profile.max_places = vm["max-places"].as<int>();
+            if (profile.max_places > 303 && naming_system == naming_system_t::short_scale)
                 throw std::invalid_argument("'max-places' must at most be '303' in the 'short-scale' naming system");
-            else if (max_places > 600 && naming_system == naming_system_t::long_scale)
+            else if (profile.max_places > 600 && naming_system == naming_system_t::long_scale)
                 throw std::invalid_argument("'max-places' must at most be '600' in the 'long-scale' naming system");
+            else if (profile.max_places < profile.min_places)
+                throw std::invalid_argument("'max-places' must not be less than 'min-places'");
+        }
+
+        if (vm.count("distribution"))
+        {
+            const auto &distribution_string = vm["distribution"].as<std::string>();
+            if (distribution_string == "uniform-places")
+                profile.distribution = magnitude_distribution_t::uniform_places;
+            else if (distribution_string == "log-uniform")
+                profile.distribution = magnitude_distribution_t::log_uniform;
+            else if (distribution_string == "zipf")
+                profile.distribution = magnitude_distribution_t::zipf;
+            else
+            {
+                const auto message = boost::format("\"%1%\" is not a valid distribution. Supported distributions "
+                                                   "are 'uniform-places', 'log-uniform' and 'zipf'.")
+                                                   % distribution_string;
+                throw std::invalid_argument(message.str());
+            }
+        }
+
+        profile.zipf_max_value = vm["zipf-max-value"].as<uint64_t>();
+        if (profile.zipf_max_value < 1)
+            throw std::invalid_argument("'zipf-max-value' must at least be '1'");
+
+        profile.zipf_exponent = vm["zipf-exponent"].as<double>();
+        if (profile.zipf_exponent <= 0.0)
+            throw std::invalid_argument("'zipf-exponent' must be greater than '0'");
+
+        profile.max_fractional_places = vm["max-fractional-places"].as<int>();
+        if (profile.max_fractional_places < 1)
+            throw std::invalid_argument("'max-fractional-places' must at least be '1'");
+
+        profile.decimal_fraction = fraction("decimal-fraction");
+        profile.negative_fraction = fraction("negative-fraction");
+        profile.scientific_fraction = fraction("scientific-fraction");
+
+        if (vm.count("numeral-fraction"))
+            profile.numeral_fraction = fraction("numeral-fraction");
+        else
+            profile.numeral_fraction = generation_mode == generation_mode_t::numeral ? 1.0 : 0.0;
+
+        profile.non_canonical_fraction = fraction("non-canonical-fraction");
+
+        profile.invalid_fraction = fraction("invalid-fraction");
+        profile.invalid_kinds = parse_invalid_kinds(vm["invalid-kinds"].as<std::string>());
+
+        if (vm.count("separator-style"))
+        {
+            const auto &separator_style_string = vm["separator-style"].as<std::string>();
+            if (separator_style_string == "none")
+                profile.separator_style = separator_style_t::none;
+            else if (separator_style_string == "english")
+                profile.separator_style = separator_style_t::english;
+            else if (separator_style_string == "german")
+                profile.separator_style = separator_style_t::german;
+            else if (separator_style_string == "mixed")
+                profile.separator_style = separator_style_t::mixed;
+            else
+            {
+                const auto message = boost::format("\"%1%\" is not a valid separator style. Supported separator "
+                                                   "styles are 'none', 'english', 'german' and 'mixed'.")
+                                                   % separator_style_string;
+                throw std::invalid_argument(message.str());
+            }
         }
     }
     catch (const std::exception &ex)
@@ -159,48 +376,68 @@ int main(int argc, const char** argv)
         return EXIT_FAILURE;
     }
 
-    num::converter_c converter;
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> digits_uniform_distribution;
-    std::uniform_int_distribution<int> places_uniform_distribution(min_places, max_places);
-    
-    for (int i = 0; i < count; i++)
-    {
-        // First, generate random number of places between the given minimum and maximum places.
-        int random_places = places_uniform_distribution(rng);
-        std::stringstream ss;
-
-        // If the maximum number of places is higher than can be generated, we have to split the task into multiple
-        // groups of random numbers and concatenate them eventually.
-        constexpr auto places_per_group = num_digits(std::numeric_limits<int>::max()) - 1;
+    num::conversion_options_t conversion_options;
+    conversion_options.naming_system = naming_system;
 
-        // Generate random numbers almost as big as possible for each group.
-        for (int places = 0; places < random_places; places += places_per_group)
-            ss << digits_uniform_distribution(rng);
+    std::vector<line_generator_c> line_generators(jobs_count,
+                                                  line_generator_c(profile, conversion_options, with_values));
 
-        std::string random_number = ss.str();
-        const auto excess = random_number.size() - random_places;
+    const auto generate_block = [&](const std::size_t job, const uint64_t first_line, const uint64_t lines_count,
+                                    std::string &buffer) {
+        buffer.clear();
 
-        // Cut the random number string down to fit the generated random number of places if required.
-        if (excess > 0)
+        for (auto line = first_line; line < first_line + lines_count; line++)
         {
-            std::uniform_int_distribution<int> offset_uniform_distribution(0, excess - 1);
-            random_number = random_number.substr(offset_uniform_distribution(rng), random_places);
-            assert(!random_number.empty());
+            counter_rng_t rng(seed, line);
+            line_generators[job].append_line(rng, buffer);
         }
+    };
 
-        // Left trim the random number and remove any leading zeroes.
-        ltrim_zeroes(random_number);
-        
-        if (generation_mode == generation_mode_t::number)
-            std::cout << random_number << "\n";
+    try
+    {
+        if (output_format == output_format_t::binary)
+        {
+            // The corpus records how it was generated.
+            std::string options;
+            for (int i = 0; i < argc; i++)
+                options.append(i > 0 ? " " : "").append(argv[i]);
+
+            num::corpus_writer_c corpus_writer(output_file, options);
+
+            generate_in_parallel(count, jobs_count, generate_block, [&](const std::string &block) {
+                for (std::size_t begin = 0, end; begin < block.size(); begin = end + 1)
+                {
+                    end = block.find('\n', begin);
+                    corpus_writer.append(std::string_view(block).substr(begin, end - begin));
+                }
+            });
+
+            corpus_writer.close();
+        }
         else
         {
-            const auto &random_numeral = converter.to_numeral(random_number);
-            std::cout << random_numeral << "\n";
+            auto *file = output_file.empty() ? stdout : std::fopen(output_file.c_str(), "wb");
+            if (!file)
+            {
+                const auto message = boost::format("unable to create output file \"%1%\"") % output_file;
+                throw std::runtime_error(message.str());
+            }
+
+            generate_in_parallel(count, jobs_count, generate_block, [&](const std::string &block) {
+                std::fwrite(block.data(), 1, block.size(), file);
+            });
+
+            if (file != stdout)
+                std::fclose(file);
+            else
+                std::fflush(stdout);
         }
     }
-    
+    catch (const std::exception &ex)
+    {
+        std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,231 @@
+#ifndef NUMERO_GENERATOR_GRAMMAR_H
+#define NUMERO_GENERATOR_GRAMMAR_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <numero/numero.h>
+
+#include "random.h"
+
+/*
+ * Renders numbers as numerals by walking the numeral grammar directly rather than converting them, so that generating
+ * numerals is not bounded by the speed of the converter. Besides the canonical numeral, which is exactly what the
+ * converter would render, it takes valid non-canonical alternatives with the given probability wherever the grammar
+ * offers some, e.g.:
+ *
+ *   - "minus" instead of "negative" and "twenty one" instead of "twenty-one"
+ *   - the article "a" instead of a leading "one", e.g. "a hundred twenty" or "a million two"
+ *   - hundreds spanning two groups, e.g. "nineteen hundred eighteen" or "twelve hundred thousand"
+ *   - composed scales, e.g. "one thousand million" instead of "one billion"
+ *   - digit word mixes, e.g. "300 thousand", "1234 thousand", "5 hundred 45 thousand 7" or "point 1 4"
+ *   - a left out leading zero, e.g. "point five"
+ */
+class numeral_grammar_c
+{
+public:
+    /*
+     * \param conversion_options Conversion options whose naming system determines the scale words.
+     * \param max_places The maximum number of places of the numbers to be rendered.
+     * \param non_canonical_fraction The probability of taking a non-canonical alternative wherever there is one.
+     */
+    numeral_grammar_c(const num::conversion_options_t &conversion_options, const int max_places,
+                      const double non_canonical_fraction) :
+        _non_canonical_fraction(non_canonical_fraction)
+    {
+        // The scale words are taken from the converter once, so that they are named exactly as it names them.
+        num::converter_c converter(conversion_options);
+        const auto groups_count = static_cast<std::size_t>(max_places + 2) / 3;
+
+        _scale_words.resize(groups_count);
+        for (std::size_t group = 1; group < groups_count; group++)
+        {
+            const auto numeral = converter.to_numeral("1" + std::string(3 * group, '0'));
+            _scale_words[group] = numeral.substr(numeral.find(' ') + 1);
+        }
+    }
+
+    /*
+     * Appends the numeral of the given number.
+     *
+     * \param negative Whether the number is negative.
+     * \param integral The integral digits of the number without leading zeros, or "0".
+     * \param fractional The fractional digits of the number; may be empty.
+     * \param buffer The buffer to append the numeral to.
+     */
+    template <class Rng>
+    void append_numeral(Rng &rng, const bool negative, const std::string &integral, const std::string &fractional,
+                        std::string &buffer) const
+    {
+        const auto numeral_begin = buffer.size();
+        const auto append_word = [&](const std::string_view &word) {
+            if (buffer.size() > numeral_begin)
+                buffer += ' ';
+            buffer += word;
+        };
+
+        if (negative)
+            append_word(non_canonical(rng) ? "minus" : "negative");
+
+        if (integral == "0")
+        {
+            if (negative || fractional.empty() || !non_canonical(rng))
+                append_word("zero");
+        }
+        else
+            append_integral(rng, integral, append_word);
+
+        if (!fractional.empty())
+        {
+            append_word("point");
+            for (const auto digit : fractional)
+            {
+                if (non_canonical(rng))
+                    append_word(std::string_view(&digit, 1));
+                else
+                    append_word(units[digit - '0']);
+            }
+        }
+    }
+
+private:
+    template <class Rng>
+    bool non_canonical(Rng &rng) const
+    {
+        return bernoulli(rng, _non_canonical_fraction);
+    }
+
+    static uint32_t group_value(const std::string &integral, const std::size_t group)
+    {
+        // Groups are counted from the least significant one.
+        const auto end = integral.size() - 3 * group;
+        const auto begin = end >= 3 ? end - 3 : 0;
+
+        uint32_t value = 0;
+        for (auto i = begin; i < end; i++)
+            value = value * 10 + static_cast<uint32_t>(integral[i] - '0');
+        return value;
+    }
+
+    template <class Rng, class AppendWord>
+    void append_integral(Rng &rng, const std::string &integral, AppendWord &&append_word) const
+    {
+        bool leading = true;
+
+        for (auto group = (integral.size() + 2) / 3; group-- > 0;)
+        {
+            const auto value = group_value(integral, group);
+            if (value == 0)
+                continue;
+
+            if (leading && group > 0 && non_canonical(rng))
+            {
+                // Digit tokens greater than 99 are only valid at the beginning, e.g. "300 thousand". The leading
+                // group may as well swallow the next one, e.g. "1234 thousand".
+                auto digits = std::to_string(value);
+                if (group > 1 && non_canonical(rng))
+                {
+                    const auto next_value = std::to_string(group_value(integral, --group));
+                    digits.append(3 - next_value.size(), '0').append(next_value);
+                }
+
+                append_word(digits);
+            }
+            else if (group > 0 && value <= 9 && group_value(integral, group - 1) >= 100 && non_canonical(rng))
+            {
+                // Hundreds spanning this and the next group, e.g. "nineteen hundred eighteen".
+                const auto next_value = group_value(integral, --group);
+                append_below_hundred(rng, value * 10 + next_value / 100, append_word);
+                append_word("hundred");
+
+                if (next_value % 100 > 0)
+                    append_below_hundred(rng, next_value % 100, append_word);
+            }
+            else
+            {
+                const auto hundreds = value / 100;
+                const auto rest = value % 100;
+
+                if (hundreds > 0)
+                {
+                    if (leading && hundreds == 1 && non_canonical(rng))
+                        append_word("a");
+                    else if (non_canonical(rng))
+                        append_word(std::to_string(hundreds));
+                    else
+                        append_word(units[hundreds]);
+
+                    append_word("hundred");
+                }
+
+                if (rest > 0)
+                {
+                    if (leading && hundreds == 0 && rest == 1 && group > 0 && non_canonical(rng))
+                        append_word("a");
+                    else
+                        append_below_hundred(rng, rest, append_word, !leading || hundreds > 0 || group > 0);
+                }
+            }
+
+            append_scale(rng, group, append_word);
+            leading = false;
+        }
+    }
+
+    /*
+     * Appends a value below one hundred in words, or in digits unless they would make up the whole integral part.
+     */
+    template <class Rng, class AppendWord>
+    void append_below_hundred(Rng &rng, const uint32_t value, AppendWord &&append_word,
+                              const bool allow_digits = true) const
+    {
+        if (allow_digits && non_canonical(rng))
+            append_word(std::to_string(value));
+        else if (value < 20)
+            append_word(units[value]);
+        else if (value % 10 == 0)
+            append_word(tens[value / 10]);
+        else if (non_canonical(rng))
+        {
+            append_word(tens[value / 10]);
+            append_word(units[value % 10]);
+        }
+        else
+            append_word(std::string(tens[value / 10]).append(1, '-').append(units[value % 10]));
+    }
+
+    template <class Rng, class AppendWord>
+    void append_scale(Rng &rng, const std::size_t group, AppendWord &&append_word) const
+    {
+        if (group == 0)
+            return;
+
+        // Every scale is a thousand times the next lower one, e.g. "one thousand million" instead of "one billion".
+        if (group > 1 && non_canonical(rng))
+        {
+            append_word("thousand");
+            append_scale(rng, group - 1, append_word);
+        }
+        else
+            append_word(_scale_words[group]);
+    }
+
+private:
+    static constexpr std::array<std::string_view, 20> units = {
+        "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine", "ten", "eleven", "twelve",
+        "thirteen", "fourteen", "fifteen", "sixteen", "seventeen", "eighteen", "nineteen"
+    };
+
+    static constexpr std::array<std::string_view, 10> tens = {
+        "", "", "twenty", "thirty", "fourty", "fifty", "sixty", "seventy", "eighty", "ninety"
+    };
+
+private:
+    const double _non_canonical_fraction;
+    std::vector<std::string> _scale_words;
+};
+
+#endif //NUMERO_GENERATOR_GRAMMAR_H
@@ -0,0 +1,230 @@
+#ifndef NUMERO_GENERATOR_PROFILE_H
+#define NUMERO_GENERATOR_PROFILE_H
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <numero/numero.h>
+
+#include "adversarial.h"
+#include "grammar.h"
+#include "random.h"
+
+/*
+ * Distributions of the magnitude of generated numbers.
+ */
+enum class magnitude_distribution_t
+{
+    uniform_places = 0,
+    log_uniform,
+    zipf
+};
+
+/*
+ * Styles of thousands and decimal separators in generated numbers.
+ */
+enum class separator_style_t
+{
+    none = 0,
+    english,
+    german,
+    mixed
+};
+
+/*
+ * A distribution profile describes what generated inputs look like, so that generated corpora can resemble real
+ * traffic rather than uniformly random numbers.
+ */
+struct profile_t
+{
+    magnitude_distribution_t distribution = magnitude_distribution_t::uniform_places;
+    int min_places = 1;
+    int max_places = 12;
+    uint64_t zipf_max_value = 1000000;
+    double zipf_exponent = 1.1;
+    double decimal_fraction = 0.0;
+    int max_fractional_places = 4;
+    double negative_fraction = 0.0;
+    double scientific_fraction = 0.0;
+    double numeral_fraction = 0.0;
+    double non_canonical_fraction = 0.0;
+    separator_style_t separator_style = separator_style_t::none;
+    double invalid_fraction = 0.0;
+    std::vector<std::pair<invalid_kind_t, double>> invalid_kinds;
+};
+
+/*
+ * Generates lines according to a distribution profile. Numbers are built digit by digit and numerals are rendered from
+ * their digits by walking the numeral grammar. Lines may be followed by a tab and the expected value of the input as
+ * the converter outputs it without thousands separators; the expected value of invalid inputs is empty.
+ */
+class line_generator_c
+{
+public:
+    line_generator_c(const profile_t &profile, const num::conversion_options_t &conversion_options,
+                     const bool with_values) :
+        _profile(profile),
+        _with_values(with_values),
+        _numeral_grammar(conversion_options, std::max(profile.max_places, 20), profile.non_canonical_fraction)
+    {
+        if (profile.distribution == magnitude_distribution_t::zipf)
+            _zipf_distribution.emplace(profile.zipf_max_value, profile.zipf_exponent);
+
+        if (profile.invalid_fraction > 0.0)
+            _invalid_line_generator.emplace(profile.invalid_kinds);
+    }
+
+    template <class Rng>
+    void append_line(Rng &rng, std::string &buffer)
+    {
+        if (_invalid_line_generator && bernoulli(rng, _profile.invalid_fraction))
+        {
+            _invalid_line_generator->append_line(rng, buffer);
+            if (_with_values)
+                buffer += '\t';
+            buffer += '\n';
+            return;
+        }
+
+        _integral.clear();
+        _fractional.clear();
+
+        append_integral(rng);
+
+        const auto negative = bernoulli(rng, _profile.negative_fraction);
+
+        if (bernoulli(rng, _profile.decimal_fraction))
+        {
+            const auto places = uniform_random(rng, 1, _profile.max_fractional_places);
+            append_random_digits(rng, static_cast<int>(places), _fractional);
+        }
+
+        if (bernoulli(rng, _profile.numeral_fraction))
+        {
+            _numeral_grammar.append_numeral(rng, negative, _integral, _fractional, buffer);
+        }
+        else if (bernoulli(rng, _profile.scientific_fraction))
+        {
+            append_scientific(negative, buffer);
+        }
+        else
+        {
+            auto style = _profile.separator_style;
+            if (style == separator_style_t::mixed)
+                style = static_cast<separator_style_t>(uniform_random(rng, 0, 2));
+
+            append_separated(negative, style, buffer);
+        }
+
+        if (_with_values)
+        {
+            buffer.append(1, '\t').append(negative ? "-" : "").append(_integral);
+            if (!_fractional.empty())
+                buffer.append(1, '.').append(_fractional);
+        }
+
+        buffer += '\n';
+    }
+
+private:
+    template <class Rng>
+    void append_integral(Rng &rng)
+    {
+        switch (_profile.distribution)
+        {
+        case magnitude_distribution_t::uniform_places:
+        {
+            const auto places = uniform_random(rng, _profile.min_places, _profile.max_places);
+            append_random_digits(rng, static_cast<int>(places), _integral);
+            break;
+        }
+        case magnitude_distribution_t::log_uniform:
+        {
+            // The decimal logarithm of the number is uniformly distributed, so that its leading digits follow
+            // Benford's law. Only the leading significant digits are derived from it, the rest is random.
+            const auto min_magnitude = static_cast<double>(_profile.min_places - 1);
+            const auto magnitude = min_magnitude + uniform_real(rng) * (_profile.max_places - min_magnitude);
+            const auto places = std::min(static_cast<int>(magnitude) + 1, _profile.max_places);
+            const auto significant_places = std::min(places, 15);
+            const auto leading = std::pow(10.0, magnitude - std::floor(magnitude) + significant_places - 1);
+            const auto leading_digits = std::min(static_cast<uint64_t>(leading),
+                                                 static_cast<uint64_t>(std::pow(10.0, significant_places)) - 1);
+
+            char digits[24];
+            const auto end = std::to_chars(std::begin(digits), std::end(digits), leading_digits).ptr;
+            _integral.append(digits, end);
+            append_random_digits(rng, places - significant_places, _integral);
+            break;
+        }
+        case magnitude_distribution_t::zipf:
+        {
+            char digits[24];
+            const auto end = std::to_chars(std::begin(digits), std::end(digits), (*_zipf_distribution)(rng)).ptr;
+            _integral.append(digits, end);
+            break;
+        }
+        }
+    }
+
+    void append_scientific(const bool negative, std::string &buffer) const
+    {
+        if (negative)
+            buffer += '-';
+
+        // The mantissa has a single integral digit and no trailing zeros.
+        auto mantissa = _integral.substr(1) + _fractional;
+        mantissa.erase(mantissa.find_last_not_of('0') + 1);
+
+        buffer += _integral[0];
+        if (!mantissa.empty())
+            buffer.append(1, '.').append(mantissa);
+
+        char exponent[16];
+        const auto end = std::to_chars(std::begin(exponent), std::end(exponent), _integral.size() - 1).ptr;
+        buffer.append(1, 'e').append(exponent, end);
+    }
+
+    void append_separated(const bool negative, const separator_style_t style, std::string &buffer) const
+    {
+        const auto thousands_separator = style == separator_style_t::german ? '.' : ',';
+        const auto decimal_separator = style == separator_style_t::german ? ',' : '.';
+
+        if (negative)
+            buffer += '-';
+
+        if (style == separator_style_t::none)
+        {
+            buffer += _integral;
+        }
+        else
+        {
+            const auto offset = _integral.size() % 3;
+            for (std::size_t i = 0; i < _integral.size(); i++)
+            {
+                if (i > 0 && i % 3 == offset)
+                    buffer += thousands_separator;
+                buffer += _integral[i];
+            }
+        }
+
+        if (!_fractional.empty())
+            buffer.append(1, decimal_separator).append(_fractional);
+    }
+
+private:
+    const profile_t _profile;
+    const bool _with_values;
+    numeral_grammar_c _numeral_grammar;
+    std::optional<zipf_distribution_t> _zipf_distribution;
+    std::optional<invalid_line_generator_c> _invalid_line_generator;
+    std::string _integral;
+    std::string _fractional;
+};
+
+#endif //NUMERO_GENERATOR_PROFILE_H
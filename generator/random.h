@@ -0,0 +1,193 @@
+#ifndef NUMERO_GENERATOR_RANDOM_H
+#define NUMERO_GENERATOR_RANDOM_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+/*
+ * Counter-based pseudo random number generator. The n-th number of a stream only depends on the seed, the stream and
+ * n, so that every generated line can have its own stream and the output is identical regardless of how lines are
+ * distributed among threads.
+ */
+class counter_rng_t
+{
+public:
+    using result_type = uint64_t;
+
+    counter_rng_t(const uint64_t seed, const uint64_t stream) :
+        _key(mix(seed ^ mix(stream + golden_gamma)))
+    {
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        return mix(_key + golden_gamma * ++_counter);
+    }
+
+private:
+    static constexpr uint64_t golden_gamma = 0x9e3779b97f4a7c15;
+
+    // The finalizer of SplitMix64.
+    static constexpr uint64_t mix(uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        return x ^ (x >> 31);
+    }
+
+private:
+    const uint64_t _key;
+    uint64_t _counter = 0;
+};
+
+/*
+ * Draws a uniformly distributed integer between min and max (both inclusive). Unlike std::uniform_int_distribution,
+ * the outcome is the same for every standard library implementation.
+ */
+template <class Rng>
+inline uint64_t uniform_random(Rng &rng, const uint64_t min, const uint64_t max)
+{
+    const auto range = max - min + 1;
+    if (range == 0)
+        return rng();
+
+    return min + static_cast<uint64_t>((static_cast<unsigned __int128>(rng()) * range) >> 64);
+}
+
+/*
+ * Appends a random number with exactly the given number of places to the target. Each 32 bits of randomness yield
+ * nine decimal digits by repeated multiplication with ten, so that no digit is formatted or converted individually.
+ */
+template <class Rng>
+inline void append_random_digits(Rng &rng, const int places, std::string &target)
+{
+    const auto offset = target.size();
+    target.resize(offset + places);
+    auto *digits = target.data() + offset;
+
+    for (int place = 0; place < places;)
+    {
+        const auto random = rng();
+
+        for (const auto half : { static_cast<uint32_t>(random), static_cast<uint32_t>(random >> 32) })
+        {
+            uint64_t fraction = half;
+            for (int i = 0; i < 9 && place < places; i++, place++)
+            {
+                fraction *= 10;
+                digits[place] = static_cast<char>('0' + (fraction >> 32));
+                fraction &= 0xffffffff;
+            }
+        }
+    }
+
+    // Numbers with more than one place must not have a leading zero.
+    if (places > 1 && digits[0] == '0')
+        digits[0] = static_cast<char>('1' + uniform_random(rng, 0, 8));
+}
+
+/*
+ * Draws a uniformly distributed real number in [0, 1).
+ */
+template <class Rng>
+inline double uniform_real(Rng &rng)
+{
+    return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+}
+
+/*
+ * Decides with the given probability between 0 and 1 whether an event occurs.
+ */
+template <class Rng>
+inline bool bernoulli(Rng &rng, const double probability)
+{
+    return probability > 0.0 && uniform_real(rng) < probability;
+}
+
+/*
+ * Zipf distribution over the integers 1 to n, where k is drawn with a probability proportional to 1 / k^exponent. It
+ * uses rejection-inversion sampling (Hörmann and Derflinger), so that it runs in constant time and memory regardless of
+ * n.
+ */
+class zipf_distribution_t
+{
+public:
+    zipf_distribution_t(const uint64_t n, const double exponent) :
+        _n(static_cast<double>(n)),
+        _exponent(exponent),
+        _h_integral_x1(h_integral(1.5) - 1.0),
+        _h_integral_n(h_integral(_n + 0.5)),
+        _s(2.0 - h_integral_inverse(h_integral(2.5) - h(2.0)))
+    {
+        if (n < 1)
+            throw std::invalid_argument("the Zipf distribution needs at least one value");
+        if (exponent <= 0.0)
+            throw std::invalid_argument("the Zipf exponent must be greater than zero");
+    }
+
+    template <class Rng>
+    uint64_t operator()(Rng &rng) const
+    {
+        for (;;)
+        {
+            const auto u = _h_integral_n + uniform_real(rng) * (_h_integral_x1 - _h_integral_n);
+            const auto x = h_integral_inverse(u);
+            auto k = std::floor(x + 0.5);
+
+            if (k < 1.0)
+                k = 1.0;
+            else if (k > _n)
+                k = _n;
+
+            if (k - x <= _s || u >= h_integral(k + 0.5) - h(k))
+                return static_cast<uint64_t>(k);
+        }
+    }
+
+private:
+    double h(const double x) const
+    {
+        return std::exp(-_exponent * std::log(x));
+    }
+
+    double h_integral(const double x) const
+    {
+        const auto log_x = std::log(x);
+        return helper2((1.0 - _exponent) * log_x) * log_x;
+    }
+
+    double h_integral_inverse(const double x) const
+    {
+        auto t = x * (1.0 - _exponent);
+        if (t < -1.0)
+            t = -1.0;
+        return std::exp(helper1(t) * x);
+    }
+
+    // log(1 + x) / x, numerically stable for small x.
+    static double helper1(const double x)
+    {
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    // (exp(x) - 1) / x, numerically stable for small x.
+    static double helper2(const double x)
+    {
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+    }
+
+private:
+    const double _n;
+    const double _exponent;
+    const double _h_integral_x1;
+    const double _h_integral_n;
+    const double _s;
+};
+
+#endif //NUMERO_GENERATOR_RANDOM_H
@@ -0,0 +1,60 @@
+#ifndef NUMERO_AGGREGATE_H
+#define NUMERO_AGGREGATE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    /*
+     * Exact count, sum, minimum, maximum and histogram of orders of magnitude of a stream of values, e.g. of a report
+     * column that mixes numerals and formatted numbers. Values are added from their significant digits straight into a
+     * big decimal accumulator of base 10^9 limbs, without formatting them as decimal numbers in between, and without
+     * any loss of precision. Positive and negative values are accumulated separately and only subtracted once the sum
+     * is requested. Aggregates of separate threads are merged at the end.
+     */
+    class value_aggregate_c
+    {
+    public:
+        void add(bool negative, int32_t exponent, const std::string_view &digits);
+        void merge(const value_aggregate_c &other);
+
+        std::string sum(char decimal_separator_symbol = '.') const;
+        std::string min(char decimal_separator_symbol = '.') const;
+        std::string max(char decimal_separator_symbol = '.') const;
+        std::vector<std::pair<value_magnitude_t, std::size_t>> histogram() const;
+
+        inline std::size_t count() const {
+            return _count;
+        }
+
+    private:
+        struct value_t
+        {
+            bool negative = false;
+            int32_t exponent = 0;
+            std::string digits;
+        };
+
+        static int compare(const value_t &a, const value_t &b);
+        static std::string format(const value_t &value, char decimal_separator_symbol);
+        void rescale(std::size_t scale);
+
+    private:
+        std::size_t _count = 0;
+        std::size_t _scale = 0;
+        std::vector<uint32_t> _positive;
+        std::vector<uint32_t> _negative;
+        value_t _min;
+        value_t _max;
+        std::map<std::pair<int, int32_t>, std::size_t> _histogram;
+    };
+};
+
+#endif //NUMERO_AGGREGATE_H
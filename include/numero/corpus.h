@@ -0,0 +1,167 @@
+#ifndef NUMERO_CORPUS_H
+#define NUMERO_CORPUS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace num
+{
+    /*
+     * Header of a binary corpus file. A corpus file consists of this header, the options text it was generated with,
+     * the blob of all concatenated inputs and finally the offset table of count + 1 offsets into the blob, each of
+     * them aligned to 8 bytes. Input i spans from offsets[i] to offsets[i + 1]. The checksum is the 64-bit FNV-1a hash
+     * of the options text, the blob and the offset table. All integers are stored in host byte order; byte_order tells
+     * whether the file was written on a host with the same byte order.
+     */
+    struct corpus_header_t
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t count;
+        uint64_t options_offset;
+        uint64_t options_size;
+        uint64_t blob_offset;
+        uint64_t blob_size;
+        uint64_t offsets_offset;
+        uint64_t checksum;
+    };
+
+    constexpr char corpus_magic[8] = { 'N', 'U', 'M', 'C', 'O', 'R', 'P', 'S' };
+    constexpr uint32_t corpus_version = 1;
+    constexpr uint32_t corpus_byte_order = 0x01020304;
+
+    /*
+     * Writes a binary corpus file. Inputs are streamed to the file as they are appended, while their offsets are
+     * spooled to a temporary file next to it, so that memory usage does not grow with the size of the corpus.
+     */
+    class corpus_writer_c
+    {
+    public:
+        corpus_writer_c(const std::string &path, const std::string_view &options);
+        ~corpus_writer_c();
+
+        corpus_writer_c(const corpus_writer_c &) = delete;
+        corpus_writer_c &operator=(const corpus_writer_c &) = delete;
+
+        void append(const std::string_view &input);
+        void close();
+
+    private:
+        void write(std::FILE *file, const void *data, std::size_t size);
+        void pad(std::FILE *file, uint64_t &position);
+
+    private:
+        std::string _path;
+        std::string _offsets_path;
+        std::FILE *_file = nullptr;
+        std::FILE *_offsets_file = nullptr;
+        corpus_header_t _header;
+        uint64_t _position = 0;
+        uint64_t _checksum;
+    };
+
+    /*
+     * Read-only view of a binary corpus file that is mapped into memory. Inputs are string views into the mapping, so
+     * that opening a corpus does not depend on the number of inputs, apart from an optional checksum verification.
+     */
+    class corpus_c
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::string_view;
+
+            iterator() = default;
+            iterator(const corpus_c *corpus, std::size_t index) : _corpus(corpus), _index(index) {}
+
+            std::string_view operator*() const { return (*_corpus)[_index]; }
+            std::string_view operator[](difference_type offset) const { return (*_corpus)[_index + offset]; }
+
+            iterator &operator++() { _index++; return *this; }
+            iterator operator++(int) { auto it = *this; _index++; return it; }
+            iterator &operator--() { _index--; return *this; }
+            iterator operator--(int) { auto it = *this; _index--; return it; }
+            iterator &operator+=(difference_type offset) { _index += offset; return *this; }
+            iterator &operator-=(difference_type offset) { _index -= offset; return *this; }
+            iterator operator+(difference_type offset) const { return iterator(_corpus, _index + offset); }
+            iterator operator-(difference_type offset) const { return iterator(_corpus, _index - offset); }
+            difference_type operator-(const iterator &other) const { return static_cast<difference_type>(_index) -
+                                                                            static_cast<difference_type>(other._index); }
+
+            bool operator==(const iterator &other) const { return _index == other._index; }
+            bool operator!=(const iterator &other) const { return _index != other._index; }
+            bool operator<(const iterator &other) const { return _index < other._index; }
+
+        private:
+            const corpus_c *_corpus = nullptr;
+            std::size_t _index = 0;
+        };
+
+        corpus_c() = default;
+        explicit corpus_c(const std::string &path, bool verify_checksum = false);
+        ~corpus_c();
+
+        corpus_c(const corpus_c &) = delete;
+        corpus_c &operator=(const corpus_c &) = delete;
+
+        static bool is_corpus(const std::string &path);
+
+        inline std::size_t size() const {
+            return _header ? _header->count : 0;
+        }
+
+        inline bool empty() const {
+            return size() == 0;
+        }
+
+        /*
+         * Gets the input at the given index. Its offsets are checked against the blob, as they are only verified
+         * up front if the corpus was opened with checksum verification.
+         * \throws std::runtime_error exception if the offsets of the input are corrupt.
+         */
+        inline std::string_view operator[](std::size_t index) const {
+            const auto begin = _offsets[index];
+            const auto end = _offsets[index + 1];
+            if (begin > end || end > _header->blob_size)
+                throw_corrupt_offsets(index);
+            return std::string_view(_blob + begin, end - begin);
+        }
+
+        inline std::string_view options() const {
+            return _header ? std::string_view(_data + _header->options_offset, _header->options_size) :
+                             std::string_view();
+        }
+
+        inline iterator begin() const {
+            return iterator(this, 0);
+        }
+
+        inline iterator end() const {
+            return iterator(this, size());
+        }
+
+    private:
+        void release();
+        [[noreturn]] void throw_corrupt_offsets(std::size_t index) const;
+
+    private:
+        const char *_data = nullptr;
+        std::size_t _size = 0;
+        const corpus_header_t *_header = nullptr;
+        const char *_blob = nullptr;
+        const uint64_t *_offsets = nullptr;
+        std::vector<char> _buffer;
+    };
+};
+
+#endif //NUMERO_CORPUS_H
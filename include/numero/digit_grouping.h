@@ -0,0 +1,63 @@
+#ifndef NUMERO_DIGIT_GROUPING_H
+#define NUMERO_DIGIT_GROUPING_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace num
+{
+    /*
+     * Grouping of the integral digits of a number: groups of three digits ("1,234,567"), the Indian grouping of a
+     * first group of three digits followed by groups of two ("12,34,567") or groups of four digits ("123,4567").
+     */
+    enum class digit_grouping_t
+    {
+        thousands = 0,
+        indian,
+        myriad
+    };
+
+    /*
+     * Gets the size of the given count of digits once grouped.
+     * \param digits_count the count of digits to group.
+     * \param separator_size the size of the separator in bytes.
+     * \param grouping the grouping of the digits.
+     * \returns the size of the grouped digits in bytes.
+     */
+    std::size_t grouped_digits_size(std::size_t digits_count, std::size_t separator_size,
+                                    digit_grouping_t grouping = digit_grouping_t::thousands);
+
+    /*
+     * Appends the given digits to the target, grouped from the least significant digit on and separated by the given
+     * separator, which may be longer than one byte, e.g. the narrow no-break space U+202F. The target is resized once
+     * and then filled right to left in a single pass.
+     * \param digits the digits to group, without sign or decimal separator.
+     * \param separator the separator to put between groups.
+     * \param grouping the grouping of the digits.
+     * \param target the string to append the grouped digits to.
+     */
+    void append_grouped_digits(const std::string_view &digits, const std::string_view &separator,
+                               digit_grouping_t grouping, std::string &target);
+
+    /*
+     * Groups the given digits from the least significant digit on and separates the groups by the given separator.
+     * \param digits the digits to group, without sign or decimal separator.
+     * \param separator the separator to put between groups.
+     * \param grouping the grouping of the digits.
+     * \returns the grouped digits.
+     */
+    std::string group_digits(const std::string_view &digits, const std::string_view &separator,
+                             digit_grouping_t grouping = digit_grouping_t::thousands);
+
+    /*
+     * Groups the digits of the target in place, i.e. without copying them to another buffer first.
+     * \param target the digits to group, without sign or decimal separator.
+     * \param separator the separator to put between groups.
+     * \param grouping the grouping of the digits.
+     */
+    void group_digits_in_place(std::string &target, const std::string_view &separator,
+                               digit_grouping_t grouping = digit_grouping_t::thousands);
+};
+
+#endif //NUMERO_DIGIT_GROUPING_H
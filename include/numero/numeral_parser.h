@@ -0,0 +1,56 @@
+#ifndef NUMERO_NUMERAL_PARSER_H
+#define NUMERO_NUMERAL_PARSER_H
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    /*
+     * States of a numeral parser after pushing a term.
+     */
+    enum class numeral_parser_state_t
+    {
+        // The terms so far may begin a numeral, but are no numeral on their own, e.g. "negative" or "three point".
+        incomplete = 0,
+        // The terms so far are a numeral on their own, which may still be continued.
+        complete,
+        // The terms so far cannot begin any numeral, no matter which terms follow.
+        invalid
+    };
+
+    /*
+     * Parses a numeral term by term, e.g. while it is being spoken. After each term, it tells whether the terms so far
+     * are still the beginning of a valid numeral and what their value is, at the cost of only that term rather than of
+     * converting all terms again. Finishing gives the same number as converting the terms joined by spaces.
+     */
+    class numeral_parser_c
+    {
+    public:
+        numeral_parser_c();
+        numeral_parser_c(const conversion_options_t &conversion_options);
+        ~numeral_parser_c();
+
+        numeral_parser_c(const numeral_parser_c &) = delete;
+        numeral_parser_c &operator=(const numeral_parser_c &) = delete;
+
+        numeral_parser_state_t push(const std::string_view &term);
+        numeral_parser_state_t push(term_id_t term);
+        std::string finish();
+        void reset();
+
+        numeral_parser_state_t state() const;
+        std::string partial_value() const;
+        std::string error() const;
+
+    private:
+        class impl_c;
+        std::unique_ptr<impl_c> _impl;
+    };
+};
+
+#endif //NUMERO_NUMERAL_PARSER_H
@@ -0,0 +1,102 @@
+#ifndef NUMERO_NUMERAL_RANGE_H
+#define NUMERO_NUMERAL_RANGE_H
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    struct group_lexicon_t;
+
+    /*
+     * Numerals of the consecutive integers from first to last, both included, e.g. for numbering checks or for sweeping
+     * all numbers of a range. The numerals are the same as those of to_numeral, but each step only renders the groups
+     * that changed again, which is a single group in 999 out of 1000 steps in groups of three places.
+     */
+    class numeral_range_c
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string *;
+            using reference = const std::string &;
+
+            static constexpr std::size_t max_groups_count = 10;
+
+            iterator() = default;
+            iterator(const group_lexicon_t *lexicon, uint64_t value, uint64_t last, bool force_leading_zero);
+
+            inline const std::string &operator*() const {
+                return _numeral;
+            }
+
+            inline const std::string *operator->() const {
+                return &_numeral;
+            }
+
+            /*
+             * Gets the integer whose numeral the iterator points to.
+             */
+            inline uint64_t value() const {
+                return _value;
+            }
+
+            iterator &operator++();
+            iterator operator++(int) { auto it = *this; ++*this; return it; }
+
+            bool operator==(const iterator &other) const { return _value == other._value && _past_end == other._past_end; }
+            bool operator!=(const iterator &other) const { return !(*this == other); }
+
+        private:
+            friend class numeral_range_c;
+
+            void render(std::size_t top_group);
+
+        private:
+            const group_lexicon_t *_lexicon = nullptr;
+            uint64_t _value = 0;
+            uint64_t _last = 0;
+            bool _past_end = true;
+
+            uint32_t _groups[max_groups_count] = {};
+            std::size_t _groups_count = 0;
+            std::size_t _group_offsets[max_groups_count] = {};
+            std::string _numeral;
+        };
+
+        numeral_range_c(uint64_t first, uint64_t last);
+        numeral_range_c(uint64_t first, uint64_t last, const conversion_options_t &conversion_options);
+
+        inline uint64_t first() const {
+            return _first;
+        }
+
+        inline uint64_t last() const {
+            return _last;
+        }
+
+        iterator begin() const;
+        iterator end() const;
+
+        std::vector<numeral_range_c> partition(std::size_t count) const;
+
+    private:
+        numeral_range_c(uint64_t first, uint64_t last, const group_lexicon_t *lexicon, bool force_leading_zero);
+
+    private:
+        uint64_t _first;
+        uint64_t _last;
+        const group_lexicon_t *_lexicon;
+        bool _force_leading_zero;
+    };
+};
+
+#endif //NUMERO_NUMERAL_RANGE_H
@@ -1,21 +1,36 @@
 #ifndef NUMERO_NUMERO_H
 #define NUMERO_NUMERO_H
 
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <regex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "numero/terms.h"
 
 namespace num
 {
     /*
-     * Types of numeral naming systems.
+     * Types of numeral naming systems: the short and long scale of "-illion" (and "-illiard") scale words in groups of
+     * three places, the Indian system of "lakh", "crore" and so on in groups of two places above the thousands, and the
+     * East Asian myriad system of "myriad", "oku", "cho" and so on in groups of four places. Undefined is the short
+     * scale.
      */
     enum class naming_system_t
     {
         undefined = 0,
         short_scale,
-        long_scale
+        long_scale,
+        indian,
+        myriad
     };
 
     /*
@@ -31,8 +46,126 @@ namespace num
         bool force_leading_zero = true;
         char thousands_separator_symbol = ',';
         char decimal_separator_symbol = '.';
+        uint32_t max_term_edits = 0;
+    };
+
+    /*
+     * Unknown term of a numeral that was replaced by the closest term of the lexicon, e.g. "hundered" by "hundred",
+     * with the number of edits between both and the position of the term in the numeral.
+     */
+    struct term_correction_t
+    {
+        std::string term;
+        std::string_view correction;
+        uint32_t edits = 0;
+        std::size_t position = 0;
+    };
+
+    /*
+     * Conversion that was run through both the converter and the reference engine in shadow mode and whose outcomes
+     * differ. A failed conversion has its exception message as result.
+     */
+    struct shadow_mismatch_t
+    {
+        std::string_view operation;
+        std::string input;
+        std::string result;
+        std::string reference_result;
+        bool failed = false;
+        bool reference_failed = false;
+    };
+
+    using shadow_mismatch_handler_t = std::function<void(const shadow_mismatch_t &)>;
+
+    /*
+     * Counters of the shadow mode: conversions sampled, conversions compared against the reference engine, samples
+     * dropped because the background comparison could not keep up, and mismatches found.
+     */
+    struct shadow_statistics_t
+    {
+        std::size_t sampled = 0;
+        std::size_t compared = 0;
+        std::size_t dropped = 0;
+        std::size_t mismatches = 0;
+    };
+
+    /*
+     * Allocator that default-initializes the elements it constructs without arguments, so that resizing a vector of
+     * characters that is about to be overwritten does not zero-fill it first.
+     */
+    template <typename T>
+    struct default_init_allocator_t : std::allocator<T>
+    {
+        template <typename U>
+        struct rebind
+        {
+            using other = default_init_allocator_t<U>;
+        };
+
+        using std::allocator<T>::allocator;
+
+        template <typename U>
+        void construct(U *pointer) noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            ::new (static_cast<void *>(pointer)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U *pointer, Args &&...args)
+        {
+            ::new (static_cast<void *>(pointer)) U(std::forward<Args>(args)...);
+        }
     };
 
+    /*
+     * Column of numerals in the layout of an Arrow string array: all numerals concatenated in one buffer and an offset
+     * table of count + 1 offsets into it. Numeral i spans from offsets[i] to offsets[i + 1].
+     */
+    struct numeral_column_t
+    {
+        std::vector<char, default_init_allocator_t<char>> data;
+        std::vector<uint64_t> offsets;
+
+        inline std::size_t size() const {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+        inline std::string_view operator[](std::size_t index) const {
+            return std::string_view(data.data() + offsets[index], offsets[index + 1] - offsets[index]);
+        }
+    };
+
+    /*
+     * Order of magnitude of a value: its sign (-1, 0 or 1) and its decimal exponent, i.e. the number of integral places
+     * for values from 1 on and the negated number of leading fractional zeros below, e.g. 3 for 125 and -1 for 0.0625.
+     */
+    struct value_magnitude_t
+    {
+        int sign = 0;
+        int32_t exponent = 0;
+    };
+
+    /*
+     * Significant digits of a value, so that it is 0.<digits> * 10^<exponent>, e.g. of a bound that many values are
+     * compared against. The digits have neither leading nor trailing zeros; zero has no digits at all.
+     */
+    struct value_digits_t
+    {
+        bool negative = false;
+        int32_t exponent = 0;
+        std::string digits;
+    };
+
+    /*
+     * Binary sort key of a value: comparing two keys bytewise, e.g. with memcmp or a radix sort, orders them like their
+     * values. Values that only differ after their first 26 significant digits get the same key.
+     */
+    using sort_key_t = std::array<uint8_t, 16>;
+
+    class result_cache_c;
+    class shadow_engine_c;
+    class value_aggregate_c;
+
     class converter_c
     {
     public:
@@ -43,9 +176,33 @@ namespace num
         bool is_number(const std::string_view &input);
 
         std::string to_number(const std::string_view &numeral);
+        std::string to_number(const std::string_view &numeral, std::vector<term_correction_t> &corrections);
+        std::string to_number(std::span<const term_id_t> numeral);
         std::string to_numeral(const std::string_view &number);
+        std::vector<term_id_t> to_numeral_terms(const std::string_view &number);
+        std::string canonicalize_numeral(const std::string_view &numeral);
+        bool is_canonical_numeral(const std::string_view &numeral) const;
         std::string convert(const std::string_view &input);
 
+        numeral_column_t to_numeral_column(std::span<const uint64_t> values);
+        numeral_column_t to_numeral_column(std::span<const uint32_t> values);
+
+        int compare_values(const std::string_view &a, const std::string_view &b);
+        int compare_values(const std::string_view &a, const value_digits_t &b);
+        value_digits_t significant_digits(const std::string_view &input);
+        value_magnitude_t estimate_magnitude(const std::string_view &input);
+        sort_key_t sort_key(const std::string_view &input);
+        uint64_t value_hash(const std::string_view &input);
+        void accumulate(const std::string_view &input, value_aggregate_c &aggregate);
+
+        void enable_shadow_mode(double sample_rate, shadow_mismatch_handler_t mismatch_handler = {});
+        void disable_shadow_mode();
+        void flush_shadow_mode();
+        shadow_statistics_t shadow_statistics() const;
+
+        void enable_result_cache(std::shared_ptr<result_cache_c> result_cache);
+        void disable_result_cache();
+
         inline conversion_options_t &conversion_options() {
             return _conversion_options;
         }
@@ -55,9 +212,19 @@ namespace num
         }
 
     private:
+        std::string convert_to_number(const std::string_view &numeral);
+        std::string convert_to_number(const std::string_view &numeral, const conversion_options_t &conversion_options);
+        std::string convert_to_number(std::span<const term_id_t> numeral);
+        std::string convert_to_numeral(const std::string_view &number);
+        std::vector<term_id_t> convert_to_numeral_terms(const std::string_view &number);
+
         bool extract_number_parts(const std::string_view &input, bool &out_negative, std::string &out_integral_part,
                                   std::string &out_fractional_part, int32_t &out_exponent,
                                   bool resolve_exponent = true);
+        std::string correct_terms(const std::string_view &numeral, std::vector<term_correction_t> &corrections);
+        void extract_significant_digits(const std::string_view &input, bool &out_negative, int32_t &out_exponent,
+                                        std::string &out_digits);
+        bool estimate_numeral_magnitude(const std::string_view &numeral, value_magnitude_t &out_magnitude);
 
         const std::regex &get_number_pattern_regex();
 
@@ -65,6 +232,8 @@ namespace num
         std::map<int16_t, const std::regex> _number_patterns;
         conversion_options_t _conversion_options;
         const std::regex _numeral_pattern;
+        std::shared_ptr<shadow_engine_c> _shadow_engine;
+        std::shared_ptr<result_cache_c> _result_cache;
     };
 };
 
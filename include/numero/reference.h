@@ -0,0 +1,53 @@
+#ifndef NUMERO_REFERENCE_H
+#define NUMERO_REFERENCE_H
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <regex>
+
+#include "numero/numero.h"
+
+namespace num::reference
+{
+    /*
+     * The reference engine is the original regular expression and bimap based converter. It is deliberately kept
+     * unchanged while num::converter_c is optimized, so that both can be run side by side and any difference in their
+     * results can be detected (see converter_c::enable_shadow_mode).
+     */
+    class converter_c
+    {
+    public:
+        converter_c();
+        converter_c(const conversion_options_t &conversion_options);
+
+        bool is_numeral(const std::string_view &input);
+        bool is_number(const std::string_view &input);
+
+        std::string to_number(const std::string_view &numeral);
+        std::string to_numeral(const std::string_view &number);
+        std::string convert(const std::string_view &input);
+
+        inline conversion_options_t &conversion_options() {
+            return _conversion_options;
+        }
+
+        inline const conversion_options_t &conversion_options() const {
+            return _conversion_options;
+        }
+
+    private:
+        bool extract_number_parts(const std::string_view &input, bool &out_negative, std::string &out_integral_part,
+                                  std::string &out_fractional_part, int32_t &out_exponent,
+                                  bool resolve_exponent = true);
+
+        const std::regex &get_number_pattern_regex();
+
+    private:
+        std::map<int16_t, const std::regex> _number_patterns;
+        conversion_options_t _conversion_options;
+        const std::regex _numeral_pattern;
+    };
+};
+
+#endif //NUMERO_REFERENCE_H
@@ -0,0 +1,76 @@
+#ifndef NUMERO_RESULT_CACHE_H
+#define NUMERO_RESULT_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    /*
+     * Header of a result cache file. A result cache file consists of this header, the slot table of slots_count 64-bit
+     * slots and the data area of data_capacity bytes, into which entries are appended. An entry consists of the
+     * fingerprint of the conversion, the sizes of input and result and the input and result themselves, aligned to
+     * 8 bytes. A slot is either zero or holds the upper bits of the hash of an entry and its offset into the data area
+     * in units of 8 bytes. The lexicon stamp is a hash of all terms of the lexicon, so that cache files are recreated
+     * whenever the lexicon changes.
+     */
+    struct result_cache_header_t
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t lexicon_stamp;
+        uint64_t slots_count;
+        uint64_t data_offset;
+        uint64_t data_capacity;
+        uint64_t data_size;
+        uint64_t entries_count;
+    };
+
+    constexpr char result_cache_magic[8] = { 'N', 'U', 'M', 'C', 'A', 'C', 'H', 'E' };
+    constexpr uint32_t result_cache_version = 1;
+
+    /*
+     * Persistent cache of conversion results in a memory-mapped file that is shared by all processes that open it. The
+     * cache is an open-addressing hash table whose slots are claimed by a single compare-and-swap each; entries are
+     * appended to the data area before their slot is published and are never changed afterwards. Hence, lookups and
+     * insertions are lock-free, also across processes. A full cache is not grown but no longer inserted into.
+     */
+    class result_cache_c
+    {
+    public:
+        explicit result_cache_c(const std::string &path, uint64_t slots_count = 1 << 20,
+                                uint64_t data_capacity = 1 << 28);
+        ~result_cache_c();
+
+        result_cache_c(const result_cache_c &) = delete;
+        result_cache_c &operator=(const result_cache_c &) = delete;
+
+        bool find(uint64_t fingerprint, const std::string_view &input, std::string &out_result) const;
+        bool insert(uint64_t fingerprint, const std::string_view &input, const std::string_view &result);
+
+        std::size_t size() const;
+
+        static uint64_t fingerprint(const conversion_options_t &conversion_options, const std::string_view &operation);
+        static uint64_t lexicon_stamp();
+
+    private:
+        bool open(const std::string &path);
+        void create(const std::string &path, uint64_t slots_count, uint64_t data_capacity);
+        void release();
+
+        bool matches(uint64_t slot, uint64_t hash, uint64_t fingerprint, const std::string_view &input) const;
+
+    private:
+        char *_data = nullptr;
+        std::size_t _size = 0;
+        result_cache_header_t *_header = nullptr;
+        uint64_t *_slots = nullptr;
+        char *_entries = nullptr;
+    };
+};
+
+#endif //NUMERO_RESULT_CACHE_H
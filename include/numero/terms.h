@@ -0,0 +1,83 @@
+#ifndef NUMERO_TERMS_H
+#define NUMERO_TERMS_H
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace num
+{
+    /*
+     * Identifier of a term of the lexicon, so that a numeral can be stored as a compact sequence of term identifiers
+     * rather than as text. The identifiers are stable:
+     *
+     *   0 - 19     units and teens, i.e. the identifier is the value of the term ("zero" to "nineteen")
+     *   20 - 27    tens ("twenty" to "ninety")
+     *   28 - 34    "hundred", "thousand", "myriad", "negative", "minus", "point" and "a"
+     *   35 - 134   "-illion" terms of the factors 1 to 100 ("million" to "centillion")
+     *   135 - 234  "-illiard" terms of the factors 1 to 100 ("milliard" to "centilliard")
+     *   235 - 245  scale words of the Indian naming system ("lakh" to "parardha")
+     *   246 - 249  scale words of the myriad naming system above "myriad" ("oku" to "gai")
+     */
+    using term_id_t = uint8_t;
+
+    constexpr term_id_t term_hundred = 28;
+    constexpr term_id_t term_thousand = 29;
+    constexpr term_id_t term_myriad = 30;
+    constexpr term_id_t term_negative = 31;
+    constexpr term_id_t term_minus = 32;
+    constexpr term_id_t term_point = 33;
+    constexpr term_id_t term_a = 34;
+    constexpr term_id_t term_lakh = 235;
+    constexpr term_id_t term_crore = 236;
+    constexpr term_id_t term_arab = 237;
+    constexpr term_id_t term_kharab = 238;
+    constexpr term_id_t term_neel = 239;
+    constexpr term_id_t term_padma = 240;
+    constexpr term_id_t term_shankh = 241;
+    constexpr term_id_t term_jaladhi = 242;
+    constexpr term_id_t term_antya = 243;
+    constexpr term_id_t term_madhya = 244;
+    constexpr term_id_t term_parardha = 245;
+    constexpr term_id_t term_oku = 246;
+    constexpr term_id_t term_cho = 247;
+    constexpr term_id_t term_kei = 248;
+    constexpr term_id_t term_gai = 249;
+    constexpr std::size_t terms_count = 250;
+
+    /*
+     * Term identifier of a unit or teen, i.e. of a value from 0 to 19.
+     */
+    constexpr term_id_t unit_term(const int value) {
+        return static_cast<term_id_t>(value);
+    }
+
+    /*
+     * Term identifier of a ten, i.e. of "twenty" (2) to "ninety" (9).
+     */
+    constexpr term_id_t tens_term(const int tens) {
+        return static_cast<term_id_t>(18 + tens);
+    }
+
+    /*
+     * Term identifier of the "-illion" term of the given factor from 1 to 100, e.g. 2 for "billion".
+     */
+    constexpr term_id_t illion_term(const int factor) {
+        return static_cast<term_id_t>(34 + factor);
+    }
+
+    /*
+     * Term identifier of the "-illiard" term of the given factor from 1 to 100, e.g. 2 for "billiard".
+     */
+    constexpr term_id_t illiard_term(const int factor) {
+        return static_cast<term_id_t>(134 + factor);
+    }
+
+    std::optional<term_id_t> find_term_id(const std::string_view &text);
+    std::string_view term_text(term_id_t term);
+    std::string render_numeral(std::span<const term_id_t> terms);
+};
+
+#endif //NUMERO_TERMS_H
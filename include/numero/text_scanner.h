@@ -0,0 +1,117 @@
+#ifndef NUMERO_TEXT_SCANNER_H
+#define NUMERO_TEXT_SCANNER_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "numero/numeral_parser.h"
+#include "numero/numero.h"
+
+namespace num
+{
+    /*
+     * Finds numerals in running text and replaces them by numbers, e.g. "revenue rose by two hundred thirty million
+     * dollars" by "revenue rose by 230,000,000 dollars". The text is pushed in chunks of any size and the result is
+     * passed to the sink as it becomes available, so that documents larger than memory can be scanned in one pass.
+     *
+     * Numerals are the longest valid sequences of words of the lexicon, regardless of their case, separated by spaces
+     * or tabs or by a single hyphen. Digits are left as they are, and so is the article "a" on its own.
+     */
+    class text_scanner_c
+    {
+    public:
+        using sink_t = std::function<void(const std::string_view &)>;
+
+        text_scanner_c(sink_t sink);
+        text_scanner_c(const conversion_options_t &conversion_options, sink_t sink);
+
+        text_scanner_c(const text_scanner_c &) = delete;
+        text_scanner_c &operator=(const text_scanner_c &) = delete;
+
+        void push(const std::string_view &chunk);
+        void finish();
+
+        inline std::size_t numerals_count() const {
+            return _numerals_count;
+        }
+
+    private:
+        struct pending_term_t
+        {
+            term_id_t term;
+            std::size_t end;
+        };
+
+        void process(char c);
+        void end_word();
+        void resolve();
+        void resolve_all();
+        void flush();
+
+    private:
+        conversion_options_t _conversion_options;
+        sink_t _sink;
+        numeral_parser_c _parser;
+
+        std::string _word;
+        bool _passing_word = false;
+        std::string _pending_text;
+        std::vector<pending_term_t> _pending_terms;
+        std::size_t _complete_terms_count = 0;
+        std::string _complete_value;
+        std::string _output;
+        std::size_t _numerals_count = 0;
+    };
+
+    /*
+     * Finds numbers in running text and replaces them by numerals, e.g. "Pay 1,250.50 by 3 pm" by "Pay one thousand two
+     * hundred fifty point five zero by three pm". The text is pushed in chunks of any size and the result is passed to
+     * the sink as it becomes available.
+     *
+     * Numbers are maximal sequences of digits, thousands separator and decimal separator symbols, optionally preceded by
+     * a minus sign, that follow the separator rules of the conversion options. Trailing separator symbols, e.g. a full
+     * stop, are not part of the number. Numbers that are joined to letters, e.g. "3rd" or "A4", are left as they are.
+     */
+    class text_verbalizer_c
+    {
+    public:
+        using sink_t = std::function<void(const std::string_view &)>;
+
+        text_verbalizer_c(sink_t sink);
+        text_verbalizer_c(const conversion_options_t &conversion_options, sink_t sink);
+
+        text_verbalizer_c(const text_verbalizer_c &) = delete;
+        text_verbalizer_c &operator=(const text_verbalizer_c &) = delete;
+
+        void push(const std::string_view &chunk);
+        void finish();
+
+        inline std::size_t numbers_count() const {
+            return _numbers_count;
+        }
+
+    private:
+        void end_token(char next);
+        bool verbalize(const std::string_view &number);
+        void flush();
+
+    private:
+        conversion_options_t _conversion_options;
+        sink_t _sink;
+
+        std::string _token;
+        char _previous = ' ';
+        std::string _integral;
+        std::string _fractional;
+        std::vector<term_id_t> _terms;
+        std::string _output;
+        std::size_t _numbers_count = 0;
+    };
+
+    std::string replace_numerals(const std::string_view &text, const conversion_options_t &conversion_options = {});
+    std::string verbalize_numbers(const std::string_view &text, const conversion_options_t &conversion_options = {});
+};
+
+#endif //NUMERO_TEXT_SCANNER_H
@@ -3,13 +3,21 @@
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include <boost/algorithm/string/replace.hpp>
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
 
+#include <numero/corpus.h>
+#include <numero/digit_grouping.h>
+#include <numero/numeral_range.h>
 #include <numero/numero.h>
+#include <numero/text_scanner.h>
 
 using hr_clock = std::chrono::high_resolution_clock;
 
@@ -66,10 +74,17 @@ int main(int argc, const char** argv)
 {
     using namespace boost::program_options;
 
+    std::string corpus_path;
+    bool verify_checksum = false;
+
     options_description program_options("Options");
     program_options.add_options()
         ( "help,h",
-          "Help and usage information" );
+          "Help and usage information" )
+        ( "corpus,c", value<std::string>(),
+          "Binary corpus file generated by numero_generator whose inputs are converted instead of the built-in examples" )
+        ( "verify-checksum", bool_switch(),
+          "Verifies the checksum of the corpus file before converting its inputs" );
         
     options_description hidden_program_options("Hidden Options");
     hidden_program_options.add_options()
@@ -100,6 +115,11 @@ int main(int argc, const char** argv)
             print_usage_information();
             return EXIT_FAILURE;
         }
+
+        if (vm.count("corpus"))
+            corpus_path = vm["corpus"].as<std::string>();
+
+        verify_checksum = vm["verify-checksum"].as<bool>();
     }
     catch (const std::exception &ex)
     {
@@ -107,6 +127,55 @@ int main(int argc, const char** argv)
         return EXIT_FAILURE;
     }
 
+    if (!corpus_path.empty())
+    {
+        try
+        {
+            // Open corpus
+            auto start = hr_clock::now();
+
+            num::corpus_c corpus(corpus_path, verify_checksum);
+
+            auto end = hr_clock::now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            std::cout << boost::format("Opening corpus of %1% inputs took %2% us") % corpus.size() % elapsed
+                      << std::endl;
+
+            // Convert all inputs of the corpus
+            num::converter_c converter;
+            std::size_t failures_count = 0;
+            std::size_t results_size = 0;
+
+            start = hr_clock::now();
+
+            for (const auto input : corpus)
+            {
+                try
+                {
+                    results_size += converter.convert(input).size();
+                }
+                catch (const std::exception &)
+                {
+                    failures_count++;
+                }
+            }
+
+            end = hr_clock::now();
+            const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            const auto average = corpus.empty() ? 0 : std::lround(static_cast<double>(elapsed_ns) / corpus.size());
+            std::cout << boost::format("Converting corpus took %1% us, on average %2% ns per input (%3% failed, "
+                                       "%4% bytes of results)") % (elapsed_ns / 1000) % average % failures_count
+                                       % results_size << std::endl;
+        }
+        catch (const std::exception &ex)
+        {
+            std::cerr << "\033[31mError: " << ex.what() << "\033[0m\n\n";
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
     // Construct converter
     auto start = hr_clock::now();
 
@@ -167,6 +236,182 @@ int main(int argc, const char** argv)
     std::cout << boost::format("Converting numeral to number took on average %1% us") % average << std::endl;
 
     results.clear();
-    
+
+    // Convert numeral given as term identifiers to number
+    std::vector<std::vector<num::term_id_t>> example_numerals_terms;
+    for (const auto &numeral : example_numerals)
+    {
+        auto &terms = example_numerals_terms.emplace_back();
+        std::string term;
+        std::istringstream terms_stream(boost::replace_all_copy(numeral, "-", " "));
+        while (terms_stream >> term)
+            terms.push_back(num::find_term_id(term).value_or(num::term_a));
+    }
+
+    start = hr_clock::now();
+
+    for (const auto &terms : example_numerals_terms)
+    {
+        try
+        {
+            results.emplace_back(converter.to_number(terms));
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+
+    end = hr_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    average = std::lround(static_cast<double>(elapsed) / example_numerals_terms.size());
+    std::cout << boost::format("Converting numeral given as term identifiers to number took on average %1% us")
+                               % average << std::endl;
+
+    results.clear();
+
+    // Compare the values of numerals
+    start = hr_clock::now();
+
+    int order_sum = 0;
+    for (std::size_t i = 0; i < example_numerals.size(); i++)
+        order_sum += converter.compare_values(example_numerals[i], example_numerals[(i + 1) % example_numerals.size()]);
+
+    end = hr_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    average = std::lround(static_cast<double>(elapsed) / example_numerals.size());
+    std::cout << boost::format("Comparing values of numerals took on average %1% us (order sum %2%)") % average
+                               % order_sum << std::endl;
+
+    // Canonicalize numerals
+    start = hr_clock::now();
+
+    for (const auto &numeral : example_numerals)
+        results.emplace_back(converter.canonicalize_numeral(numeral));
+
+    end = hr_clock::now();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    average = std::lround(static_cast<double>(elapsed) / example_numerals.size());
+    std::cout << boost::format("Canonicalizing numeral took on average %1% us") % average << std::endl;
+
+    results.clear();
+
+    // Convert a column of integers to numerals
+    std::vector<uint64_t> column_values(1000000);
+    for (std::size_t i = 0; i < column_values.size(); i++)
+        column_values[i] = (i * 7919) % 100000;
+
+    // Convert one value up front, so that the lexicon of group numerals is not built while timing.
+    converter.to_numeral_column(std::span<const uint64_t>(column_values.data(), 1));
+
+    start = hr_clock::now();
+
+    const auto column = converter.to_numeral_column(column_values);
+
+    end = hr_clock::now();
+    const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << boost::format("Converting a column of %1% integers to numerals took on average %2% ns per value")
+                               % column.size() % (static_cast<double>(elapsed_ns) / column_values.size())
+              << std::endl;
+
+    // Render the numerals of a range of consecutive integers
+    const num::numeral_range_c range(1, 1000000, converter.conversion_options());
+    std::size_t range_size = 0;
+
+    start = hr_clock::now();
+
+    for (const auto &numeral : range)
+        range_size += numeral.size();
+
+    end = hr_clock::now();
+    const auto range_elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << boost::format("Rendering a range of %1% consecutive numerals took on average %2% ns per value "
+                               "(%3% bytes)") % (range.last() - range.first() + 1)
+                               % (static_cast<double>(range_elapsed_ns) / (range.last() - range.first() + 1))
+                               % range_size << std::endl;
+
+    // Verbalize the numbers of a running text
+    std::string text;
+    for (std::size_t i = 0; text.size() < (1 << 24); i++)
+        text += (boost::format("On day %1% the account held %2%.%3% dollars, according to the report. ")
+                               % (i % 365) % ((i * 7919) % 1000000) % (i % 100)).str();
+
+    std::size_t verbalized_size = 0;
+    num::text_verbalizer_c text_verbalizer(converter.conversion_options(),
+                                           [&](const std::string_view &output) { verbalized_size += output.size(); });
+
+    start = hr_clock::now();
+
+    for (std::size_t position = 0; position < text.size(); position += 1 << 16)
+        text_verbalizer.push(std::string_view(text).substr(position, 1 << 16));
+    text_verbalizer.finish();
+
+    end = hr_clock::now();
+    const auto text_elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << boost::format("Verbalizing %1% numbers in %2% bytes of text took %3% MB/s (%4% bytes)")
+                               % text_verbalizer.numbers_count() % text.size()
+                               % (static_cast<double>(text.size()) * 1000.0 / text_elapsed_ns) % verbalized_size
+              << std::endl;
+
+    // Convert English and German numerals of the same values to numbers
+    num::conversion_options_t german_conversion_options;
+    german_conversion_options.language = "de";
+    num::converter_c english_converter;
+    num::converter_c german_converter(german_conversion_options);
+
+    for (auto *language_converter : { &english_converter, &german_converter })
+    {
+        std::vector<std::string> numerals;
+        std::size_t numerals_size = 0;
+        for (uint64_t i = 1; i <= 10000; i++)
+        {
+            numerals.push_back(language_converter->to_numeral(std::to_string((i * 7919 * 7919) % 1000000000000)));
+            numerals_size += numerals.back().size();
+        }
+
+        std::size_t numbers_size = 0;
+
+        start = hr_clock::now();
+
+        for (const auto &numeral : numerals)
+            numbers_size += language_converter->to_number(numeral).size();
+
+        end = hr_clock::now();
+        const auto numerals_elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        std::cout << boost::format("Converting %1% numerals of language \"%2%\" to numbers took %3% MB/s (%4% bytes)")
+                                   % numerals.size() % language_converter->conversion_options().language
+                                   % (static_cast<double>(numerals_size) * 1000.0 / numerals_elapsed_ns)
+                                   % numbers_size << std::endl;
+    }
+
+    // Group the digits of long numbers by each digit grouping, separated by a narrow no-break space (U+202F)
+    std::string digit_runs;
+    for (uint64_t i = 1; digit_runs.size() < (1 << 22); i++)
+        digit_runs += std::to_string(i * 7919 * 7919 * 7919);
+
+    const std::pair<num::digit_grouping_t, std::string_view> groupings[] = {
+        { num::digit_grouping_t::thousands, "thousands" },
+        { num::digit_grouping_t::indian, "Indian" },
+        { num::digit_grouping_t::myriad, "myriad" }
+    };
+
+    for (const auto &[grouping, grouping_name] : groupings)
+    {
+        std::string grouped;
+        start = hr_clock::now();
+
+        for (std::size_t position = 0; position < digit_runs.size(); position += 40)
+        {
+            grouped.clear();
+            num::append_grouped_digits(std::string_view(digit_runs).substr(position, 40), "\u202f", grouping, grouped);
+        }
+
+        end = hr_clock::now();
+        const auto grouping_elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        std::cout << boost::format("Grouping %1% digits in runs of 40 by %2% grouping took %3% MB/s")
+                                   % digit_runs.size() % grouping_name
+                                   % (static_cast<double>(digit_runs.size()) * 1000.0 / grouping_elapsed_ns)
+                  << std::endl;
+    }
+
     return EXIT_SUCCESS;
 }
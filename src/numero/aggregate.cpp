@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "numero/aggregate.h"
+
+namespace num
+{
+    namespace
+    {
+        constexpr uint32_t limb_base = 1000000000;
+        constexpr std::size_t limb_digits = 9;
+        constexpr uint32_t powers_of_ten[limb_digits] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+                                                          100000000 };
+
+        void trim(std::vector<uint32_t> &limbs)
+        {
+            while (!limbs.empty() && limbs.back() == 0)
+                limbs.pop_back();
+        }
+
+        void normalize(std::vector<uint32_t> &limbs, std::size_t first)
+        {
+            uint32_t carry = 0;
+            for (auto i = first; i < limbs.size(); i++)
+            {
+                limbs[i] += carry;
+                carry = limbs[i] / limb_base;
+                limbs[i] %= limb_base;
+            }
+
+            if (carry > 0)
+                limbs.push_back(carry);
+
+            trim(limbs);
+        }
+
+        /*
+         * Multiplies a magnitude by 10^count.
+         */
+        void shift(std::vector<uint32_t> &limbs, const std::size_t count)
+        {
+            if (limbs.empty())
+                return;
+
+            limbs.insert(limbs.begin(), count / limb_digits, 0);
+
+            const auto factor = powers_of_ten[count % limb_digits];
+            if (factor == 1)
+                return;
+
+            uint64_t carry = 0;
+            for (auto &limb : limbs)
+            {
+                const auto product = static_cast<uint64_t>(limb) * factor + carry;
+                limb = static_cast<uint32_t>(product % limb_base);
+                carry = product / limb_base;
+            }
+
+            if (carry > 0)
+                limbs.push_back(static_cast<uint32_t>(carry));
+        }
+
+        /*
+         * Adds the decimal digits of an integer, multiplied by 10^count, to a magnitude. Each limb receives at most
+         * nine digits, so that it stays below 2 * 10^9 until it is normalized.
+         */
+        void add_digits(std::vector<uint32_t> &limbs, const std::string_view &digits, const std::size_t count)
+        {
+            const auto end = count + digits.size();
+            if (limbs.size() < (end + limb_digits - 1) / limb_digits)
+                limbs.resize((end + limb_digits - 1) / limb_digits);
+
+            for (std::size_t i = 0; i < digits.size(); i++)
+            {
+                const auto position = end - 1 - i;
+                limbs[position / limb_digits] += static_cast<uint32_t>(digits[i] - '0') *
+                                                 powers_of_ten[position % limb_digits];
+            }
+
+            normalize(limbs, count / limb_digits);
+        }
+
+        void add_limbs(std::vector<uint32_t> &limbs, const std::vector<uint32_t> &other)
+        {
+            if (limbs.size() < other.size())
+                limbs.resize(other.size());
+
+            for (std::size_t i = 0; i < other.size(); i++)
+                limbs[i] += other[i];
+
+            normalize(limbs, 0);
+        }
+
+        int compare_limbs(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+        {
+            if (a.size() != b.size())
+                return a.size() < b.size() ? -1 : 1;
+
+            for (auto i = a.size(); i-- > 0;)
+            {
+                if (a[i] != b[i])
+                    return a[i] < b[i] ? -1 : 1;
+            }
+
+            return 0;
+        }
+
+        /*
+         * Subtracts a magnitude from a greater or equal one.
+         */
+        std::vector<uint32_t> subtract_limbs(std::vector<uint32_t> a, const std::vector<uint32_t> &b)
+        {
+            int64_t borrow = 0;
+            for (std::size_t i = 0; i < a.size(); i++)
+            {
+                auto difference = static_cast<int64_t>(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+                borrow = difference < 0 ? 1 : 0;
+                a[i] = static_cast<uint32_t>(difference + borrow * limb_base);
+            }
+
+            trim(a);
+            return a;
+        }
+
+        std::string limbs_to_digits(const std::vector<uint32_t> &limbs)
+        {
+            if (limbs.empty())
+                return {};
+
+            std::string digits = std::to_string(limbs.back());
+            for (auto i = limbs.size() - 1; i-- > 0;)
+            {
+                const auto limb = std::to_string(limbs[i]);
+                digits.append(limb_digits - limb.size(), '0');
+                digits += limb;
+            }
+
+            return digits;
+        }
+    }
+
+    /*
+     * Adds a value given by its significant digits, so that it is 0.<digits> * 10^<exponent>, as extracted from a number
+     * or numeral by converter_c::accumulate.
+     * \param negative Whether the value is negative.
+     * \param exponent The decimal exponent of the value.
+     * \param digits The significant digits without leading and trailing zeros; none for zero.
+     */
+    void value_aggregate_c::add(const bool negative, const int32_t exponent, const std::string_view &digits)
+    {
+        const value_t value { negative && !digits.empty(), digits.empty() ? 0 : exponent, std::string(digits) };
+
+        if (_count == 0 || compare(value, _min) < 0)
+            _min = value;
+        if (_count == 0 || compare(value, _max) > 0)
+            _max = value;
+
+        _count++;
+
+        const auto sign = digits.empty() ? 0 : value.negative ? -1 : 1;
+        _histogram[{ sign, sign * value.exponent }]++;
+
+        if (digits.empty())
+            return;
+
+        // The value is digits * 10^(exponent - size), which needs a scale of at least size - exponent fractional places.
+        const auto places = static_cast<int64_t>(digits.size()) - exponent;
+        if (places > static_cast<int64_t>(_scale))
+            rescale(static_cast<std::size_t>(places));
+
+        const auto count = static_cast<std::size_t>(static_cast<int64_t>(_scale) - places);
+        add_digits(value.negative ? _negative : _positive, digits, count);
+    }
+
+    /*
+     * Merges the aggregate of another part of the values, e.g. of another thread, into this one.
+     */
+    void value_aggregate_c::merge(const value_aggregate_c &other)
+    {
+        if (other._count == 0)
+            return;
+
+        if (_count == 0 || compare(other._min, _min) < 0)
+            _min = other._min;
+        if (_count == 0 || compare(other._max, _max) > 0)
+            _max = other._max;
+
+        _count += other._count;
+
+        for (const auto &[bucket, count] : other._histogram)
+            _histogram[bucket] += count;
+
+        if (other._scale > _scale)
+            rescale(other._scale);
+
+        auto positive = other._positive;
+        auto negative = other._negative;
+        shift(positive, _scale - other._scale);
+        shift(negative, _scale - other._scale);
+        add_limbs(_positive, positive);
+        add_limbs(_negative, negative);
+    }
+
+    /*
+     * Gets the exact sum of all values as a decimal number without thousands separators, e.g. "-1234.5".
+     */
+    std::string value_aggregate_c::sum(const char decimal_separator_symbol) const
+    {
+        const auto order = compare_limbs(_positive, _negative);
+        const auto magnitude = order >= 0 ? subtract_limbs(_positive, _negative) : subtract_limbs(_negative, _positive);
+
+        value_t value;
+        value.digits = limbs_to_digits(magnitude);
+        value.negative = order < 0;
+        value.exponent = static_cast<int32_t>(value.digits.size()) - static_cast<int32_t>(_scale);
+        value.digits.erase(std::min(value.digits.find_last_not_of('0') + 1, value.digits.size()));
+
+        return format(value, decimal_separator_symbol);
+    }
+
+    /*
+     * Gets the least value as a decimal number without thousands separators.
+     */
+    std::string value_aggregate_c::min(const char decimal_separator_symbol) const
+    {
+        return format(_min, decimal_separator_symbol);
+    }
+
+    /*
+     * Gets the greatest value as a decimal number without thousands separators.
+     */
+    std::string value_aggregate_c::max(const char decimal_separator_symbol) const
+    {
+        return format(_max, decimal_separator_symbol);
+    }
+
+    /*
+     * Gets the number of values per order of magnitude in ascending order of values, e.g. the number of values from 100
+     * to 999.99... as those of exponent 3 and sign 1.
+     */
+    std::vector<std::pair<value_magnitude_t, std::size_t>> value_aggregate_c::histogram() const
+    {
+        std::vector<std::pair<value_magnitude_t, std::size_t>> histogram;
+        histogram.reserve(_histogram.size());
+
+        for (const auto &[bucket, count] : _histogram)
+            histogram.push_back({ { bucket.first, bucket.first * bucket.second }, count });
+
+        return histogram;
+    }
+
+    int value_aggregate_c::compare(const value_t &a, const value_t &b)
+    {
+        const auto a_sign = a.digits.empty() ? 0 : a.negative ? -1 : 1;
+        const auto b_sign = b.digits.empty() ? 0 : b.negative ? -1 : 1;
+
+        if (a_sign != b_sign)
+            return a_sign < b_sign ? -1 : 1;
+
+        if (a_sign == 0)
+            return 0;
+
+        const auto magnitude_order = a.exponent != b.exponent ? (a.exponent < b.exponent ? -1 : 1) :
+                                     a.digits.compare(b.digits);
+        return magnitude_order == 0 ? 0 : (magnitude_order < 0) == (a_sign > 0) ? -1 : 1;
+    }
+
+    std::string value_aggregate_c::format(const value_t &value, const char decimal_separator_symbol)
+    {
+        if (value.digits.empty())
+            return "0";
+
+        const auto size = static_cast<int64_t>(value.digits.size());
+        std::string number = value.negative ? "-" : "";
+
+        if (value.exponent <= 0)
+        {
+            number += '0';
+            number += decimal_separator_symbol;
+            number.append(static_cast<std::size_t>(-value.exponent), '0');
+            number += value.digits;
+        }
+        else if (value.exponent >= size)
+        {
+            number += value.digits;
+            number.append(static_cast<std::size_t>(value.exponent - size), '0');
+        }
+        else
+        {
+            number.append(value.digits, 0, static_cast<std::size_t>(value.exponent));
+            number += decimal_separator_symbol;
+            number.append(value.digits, static_cast<std::size_t>(value.exponent));
+        }
+
+        return number;
+    }
+
+    void value_aggregate_c::rescale(const std::size_t scale)
+    {
+        shift(_positive, scale - _scale);
+        shift(_negative, scale - _scale);
+        _scale = scale;
+    }
+
+    /*
+     * Adds the value of a number or numeral to an aggregate. Only the significant digits of the value are extracted; it
+     * is neither converted nor formatted as a decimal number.
+     * \param input The number or numeral.
+     * \param aggregate The aggregate to add the value to.
+     * \throws std::invalid_argument exception if the input is invalid.
+     * \throws std::out_of_range exception if the exponent of a number is out of the supported range.
+     */
+    void converter_c::accumulate(const std::string_view &input, value_aggregate_c &aggregate)
+    {
+        bool negative;
+        int32_t exponent;
+        std::string digits;
+        extract_significant_digits(input, negative, exponent, digits);
+        aggregate.add(negative, exponent, digits);
+    }
+}
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "numero/numero.h"
+#include "german.h"
+#include "naming_system.h"
+
+namespace num
+{
+    void append_numeral_terms(bool negative, const std::string_view &integral, const std::string_view &fractional,
+                              const conversion_options_t &conversion_options, std::vector<term_id_t> &terms);
+    void parse_numeral_digits(const std::string_view &numeral, const conversion_options_t &conversion_options,
+                              bool &out_negative, std::string &out_integral_part, std::string &out_fractional_part);
+
+    namespace
+    {
+        /*
+         * Converts a German numeral to its canonical form by parsing it into its digits and rendering them again.
+         * \throws std::invalid_argument exception if the numeral is empty or invalid.
+         */
+        std::string canonicalize_german_numeral(const std::string_view &numeral,
+                                                const conversion_options_t &conversion_options)
+        {
+            auto digits_options = conversion_options;
+            digits_options.use_thousands_separators = false;
+            digits_options.decimal_separator_symbol = '.';
+
+            const auto number = parse_german_numeral(numeral, digits_options);
+            const auto negative = number.front() == '-';
+            const auto integral_begin = negative ? 1 : 0;
+            const auto point = std::min(number.find('.'), number.size());
+            const auto fractional_begin = std::min(point + 1, number.size());
+
+            return render_german_numeral(negative,
+                                         std::string_view(number).substr(integral_begin, point - integral_begin),
+                                         std::string_view(number).substr(fractional_begin), conversion_options);
+        }
+
+        /*
+         * Places of the numerals within a group, in the order in which canonical numerals have them,
+         * e.g. "five hundred" before "twenty" before "-one".
+         */
+        enum class group_stage_t
+        {
+            // No term of the group yet, e.g. at the beginning or after a scale word.
+            none = 0,
+            // A unit, which is either followed by "hundred" or is the rest of the group.
+            unit,
+            hundred,
+            tens,
+            // The rest of the group below one hundred is complete.
+            rest
+        };
+
+        /*
+         * Checks whether a group of the given size can have hundreds of the given number of places, i.e. a unit
+         * ("five hundred") in groups of at least three places and tens or teens ("twelve hundred") in groups of four.
+         */
+        inline bool hundreds_fit(const uint32_t hundreds_places, const uint32_t group_size)
+        {
+            return hundreds_places == 0 || hundreds_places + 2 <= group_size;
+        }
+    }
+
+    /*
+     * Checks whether a numeral is canonical, i.e. exactly what to_numeral renders for its value. The numeral is checked
+     * in a single pass over its terms, without converting it: groups have to be composed of hundreds, tens and units in
+     * their canonical form, each followed by a scale word of lower place than the one before that names a group of the
+     * naming system, and terms have to be separated by single spaces, or by a hyphen between tens and units. German
+     * numerals are checked by canonicalizing them instead.
+     * \param numeral The numeral to be checked.
+     * \returns True if the numeral is canonical, false otherwise, which includes invalid numerals.
+     */
+    bool converter_c::is_canonical_numeral(const std::string_view &numeral) const
+    {
+        if (is_german(_conversion_options))
+        {
+            try
+            {
+                return canonicalize_german_numeral(numeral, _conversion_options) == numeral;
+            }
+            catch (const std::invalid_argument &)
+            {
+                return false;
+            }
+        }
+
+        const auto &naming_system_table = get_naming_system_table(_conversion_options.naming_system);
+        auto stage = group_stage_t::none;
+        uint32_t hundreds_places = 0;
+        auto last_place = std::numeric_limits<uint32_t>::max();
+        bool negative = false;
+        bool zero = false;
+        bool integral = false;
+        bool fractional = false;
+        std::size_t fractional_digits_count = 0;
+        term_id_t previous = term_point;
+
+        for (std::size_t begin = 0, end; begin <= numeral.size(); begin = end + 1)
+        {
+            for (end = begin; end < numeral.size() && numeral[end] >= 'a' && numeral[end] <= 'z'; end++);
+
+            if (end == begin || (end < numeral.size() && numeral[end] != ' ' && numeral[end] != '-'))
+                return false;
+
+            const auto term_id = find_term_id(numeral.substr(begin, end - begin));
+            if (!term_id)
+                return false;
+
+            const auto term = *term_id;
+
+            // A hyphen joins tens and units and nothing else.
+            const auto joined = previous >= tens_term(2) && previous <= tens_term(9) &&
+                                term >= unit_term(1) && term <= unit_term(9);
+            if (begin > 0 && (numeral[begin - 1] == '-') != joined)
+                return false;
+
+            previous = term;
+
+            if (fractional)
+            {
+                if (term > unit_term(9))
+                    return false;
+
+                fractional_digits_count++;
+                continue;
+            }
+
+            if (term == term_negative && begin == 0)
+            {
+                negative = true;
+            }
+            else if (term == term_point)
+            {
+                // A zero integral part is only left out if no leading zero is forced, and never after a sign.
+                if (!integral && (negative || _conversion_options.force_leading_zero))
+                    return false;
+                fractional = true;
+            }
+            else if (zero)
+            {
+                return false;
+            }
+            else if (term == unit_term(0))
+            {
+                if (integral)
+                    return false;
+                zero = integral = true;
+            }
+            else if (term <= unit_term(9))
+            {
+                if (stage == group_stage_t::none)
+                    stage = group_stage_t::unit;
+                else if (stage == group_stage_t::hundred || stage == group_stage_t::tens)
+                    stage = group_stage_t::rest;
+                else
+                    return false;
+                integral = true;
+            }
+            else if (term <= tens_term(9))
+            {
+                if (stage != group_stage_t::none && stage != group_stage_t::hundred)
+                    return false;
+                stage = term <= unit_term(19) ? group_stage_t::rest : group_stage_t::tens;
+                integral = true;
+            }
+            else if (term == term_hundred)
+            {
+                if (hundreds_places > 0 || stage == group_stage_t::none || stage == group_stage_t::hundred)
+                    return false;
+                hundreds_places = stage == group_stage_t::unit ? 1 : 2;
+                stage = group_stage_t::hundred;
+            }
+            else
+            {
+                const auto place = naming_system_table.scale_places[term];
+                if (place == 0 || place >= last_place || stage == group_stage_t::none ||
+                    !hundreds_fit(hundreds_places, naming_system_table.scale_group_sizes[term]))
+                    return false;
+                last_place = place;
+                stage = group_stage_t::none;
+                hundreds_places = 0;
+            }
+        }
+
+        if (!hundreds_fit(hundreds_places, naming_system_table.group_size(0)))
+            return false;
+
+        // A zero integral part without a sign is left out as well if no leading zero is forced.
+        if (zero && !negative && !_conversion_options.force_leading_zero)
+            return false;
+
+        return fractional ? fractional_digits_count > 0 : integral;
+    }
+
+    /*
+     * Converts a numeral to its canonical form, e.g. "nineteen hundred eighteen" to "one thousand nine hundred
+     * eighteen". The result is the same as converting the numeral to a number and back, but the digits merged from the
+     * groups of the parsed numeral are turned into terms directly instead of through formatting and parsing a number.
+     * Canonical numerals are recognized in a single pass and returned unchanged. German numerals are parsed and rendered
+     * by the German engine.
+     * \param numeral The numeral to be canonicalized.
+     * \returns the canonical numeral.
+     * \throws std::invalid_argument exception if the numeral is empty or invalid.
+     */
+    std::string converter_c::canonicalize_numeral(const std::string_view &numeral)
+    {
+        if (is_german(_conversion_options))
+            return canonicalize_german_numeral(numeral, _conversion_options);
+
+        if (is_canonical_numeral(numeral))
+            return std::string(numeral);
+
+        bool negative;
+        std::string integral;
+        std::string fractional;
+        parse_numeral_digits(numeral, _conversion_options, negative, integral, fractional);
+
+        // A left out integral part is zero, e.g. in "point five".
+        if (integral.empty())
+            integral = "0";
+
+        std::vector<term_id_t> terms;
+        append_numeral_terms(negative, integral, fractional, _conversion_options, terms);
+        return render_numeral(terms);
+    }
+}
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "numero/numero.h"
+#include "german.h"
+#include "group_lexicon.h"
+#include "naming_system.h"
+
+namespace num
+{
+    std::string parse_integral_numeral(const std::string_view &integral, const conversion_options_t &conversion_options);
+
+    group_lexicon_t::group_lexicon_t(const naming_system_t naming_system)
+    {
+        conversion_options_t conversion_options;
+        conversion_options.naming_system = naming_system;
+
+        const auto &naming_system_table = get_naming_system_table(naming_system);
+        uint32_t max_radix = 0;
+
+        for (std::size_t group = 0; group < max_groups_count; group++)
+        {
+            const auto table_group = std::min(group, naming_system_table.groups_count() - 1);
+            radices[group] = 1;
+            for (uint32_t place = 0; place < naming_system_table.group_size(table_group); place++)
+                radices[group] *= 10;
+            max_radix = std::max(max_radix, radices[group]);
+
+            // Scale words are stored with their leading space, e.g. " million".
+            if (group > 0 && group < naming_system_table.groups_count())
+            {
+                const auto place = naming_system_table.group_places[group];
+                const auto numeral = parse_integral_numeral("1" + std::string(place, '0'), conversion_options);
+                scale_words[group] = numeral.substr(numeral.find(' '));
+
+                if (scale_words[group].size() > chunk_size)
+                    throw std::logic_error("the scale word does not fit into a chunk of the group lexicon");
+                std::memcpy(scale_word_chunks[group].data(), scale_words[group].data(), scale_words[group].size());
+            }
+        }
+
+        phrase_offsets.resize(max_radix);
+        phrase_sizes.resize(max_radix);
+
+        for (uint32_t value = 0; value < max_radix; value++)
+        {
+            const auto phrase = parse_integral_numeral(std::to_string(value), conversion_options);
+            phrase_offsets[value] = static_cast<uint32_t>(phrases.size());
+            phrase_sizes[value] = static_cast<uint8_t>(phrase.size());
+            phrases += phrase;
+
+            if (phrase.size() > chunk_size)
+                throw std::logic_error("the phrase does not fit into a chunk of the group lexicon");
+        }
+
+        phrases.append(chunk_size, ' ');
+    }
+
+    const group_lexicon_t &get_group_lexicon(const naming_system_t naming_system)
+    {
+        switch (naming_system)
+        {
+        case naming_system_t::long_scale:
+        {
+            static const group_lexicon_t long_scale_lexicon(naming_system_t::long_scale);
+            return long_scale_lexicon;
+        }
+        case naming_system_t::indian:
+        {
+            static const group_lexicon_t indian_lexicon(naming_system_t::indian);
+            return indian_lexicon;
+        }
+        case naming_system_t::myriad:
+        {
+            static const group_lexicon_t myriad_lexicon(naming_system_t::myriad);
+            return myriad_lexicon;
+        }
+        default:
+        {
+            static const group_lexicon_t short_scale_lexicon(naming_system_t::short_scale);
+            return short_scale_lexicon;
+        }
+        }
+    }
+
+    namespace
+    {
+        /*
+         * Splits the value into groups like split_groups, but by radices known at compile time, so that the divisions
+         * are turned into multiplications. The first group may have a radix of its own, e.g. 1,000 in the Indian system.
+         */
+        template <uint32_t FirstRadix, uint32_t Radix>
+        struct constant_radices_t
+        {
+            inline std::size_t operator()(uint64_t value, uint32_t (&groups)[group_lexicon_t::max_groups_count]) const
+            {
+                if (value == 0)
+                    return 0;
+
+                groups[0] = static_cast<uint32_t>(value % FirstRadix);
+                value /= FirstRadix;
+
+                std::size_t groups_count = 1;
+                for (; value > 0; groups_count++)
+                {
+                    groups[groups_count] = static_cast<uint32_t>(value % Radix);
+                    value /= Radix;
+                }
+                return groups_count;
+            }
+        };
+
+        /*
+         * Renders the values in blocks of rows. For each block, the values are split into groups and the sizes of all
+         * numerals are summed up from the precomputed phrase sizes first, so that the block is written in one go from
+         * the same groups without any per row allocations.
+         */
+        template <typename T, typename SplitGroups>
+        numeral_column_t render_numeral_column(const std::span<const T> values, const group_lexicon_t &lexicon,
+                                               const bool force_leading_zero, const SplitGroups split)
+        {
+            constexpr std::size_t rows_per_block = 1024;
+            const auto zero_size = force_leading_zero ? lexicon.phrase_sizes[0] : 0;
+
+            numeral_column_t column;
+            column.offsets.resize(values.size() + 1);
+            column.offsets[0] = 0;
+
+            struct row_groups_t
+            {
+                uint32_t groups[group_lexicon_t::max_groups_count];
+                std::size_t groups_count;
+            };
+
+            std::vector<row_groups_t> block_groups(rows_per_block);
+
+            for (std::size_t block_begin = 0; block_begin < values.size(); block_begin += rows_per_block)
+            {
+                const auto block_rows = std::min(rows_per_block, values.size() - block_begin);
+                auto offset = column.offsets[block_begin];
+
+                for (std::size_t row = 0; row < block_rows; row++)
+                {
+                    auto &groups = block_groups[row].groups;
+                    const auto groups_count = split(values[block_begin + row], groups);
+                    block_groups[row].groups_count = groups_count;
+
+                    uint64_t size = groups_count == 0 ? zero_size : 0;
+
+                    for (std::size_t group = 0; group < groups_count; group++)
+                    {
+                        if (groups[group] == 0)
+                            continue;
+
+                        size += (size > 0) + lexicon.phrase_sizes[groups[group]] + lexicon.scale_words[group].size();
+                    }
+
+                    offset += size;
+                    column.offsets[block_begin + row + 1] = offset;
+                }
+
+                // Reserve the buffer for all rows at the average size of the first block, so that it is rarely moved.
+                // It is default-initialized, so growing it does not zero-fill what is overwritten next.
+                if (block_begin == 0)
+                    column.data.reserve(offset + offset / block_rows * (values.size() - block_rows) * 5 / 4);
+
+                // Phrases and scale words are copied in chunks of fixed size, of which the excess is overwritten by
+                // the next one, so the buffer has room for one more chunk.
+                column.data.resize(offset + group_lexicon_t::chunk_size);
+
+                for (std::size_t row = 0; row < block_rows; row++)
+                {
+                    auto *target = column.data.data() + column.offsets[block_begin + row];
+                    const auto &[groups, groups_count] = block_groups[row];
+
+                    if (groups_count == 0)
+                    {
+                        std::memcpy(target, lexicon.phrases.data() + lexicon.phrase_offsets[0],
+                                    group_lexicon_t::chunk_size);
+                        continue;
+                    }
+
+                    const auto *const begin = target;
+                    for (auto group = groups_count; group-- > 0;)
+                    {
+                        const auto value = groups[group];
+                        if (value == 0)
+                            continue;
+
+                        if (target != begin)
+                            *target++ = ' ';
+
+                        std::memcpy(target, lexicon.phrases.data() + lexicon.phrase_offsets[value],
+                                    group_lexicon_t::chunk_size);
+                        target += lexicon.phrase_sizes[value];
+
+                        std::memcpy(target, lexicon.scale_word_chunks[group].data(), group_lexicon_t::chunk_size);
+                        target += lexicon.scale_words[group].size();
+                    }
+                }
+
+                column.data.resize(offset);
+            }
+
+            return column;
+        }
+
+        /*
+         * Renders the values with the divisions specialized for the radices of the common naming systems: the short
+         * and the long scale, the Indian and the myriad system.
+         */
+        template <typename T>
+        numeral_column_t render_numeral_column(const std::span<const T> values, const group_lexicon_t &lexicon,
+                                               const bool force_leading_zero)
+        {
+            const auto first_radix = lexicon.radices[0];
+            const auto radix = lexicon.radices[1];
+
+            if (first_radix == 1000 && radix == 1000)
+                return render_numeral_column(values, lexicon, force_leading_zero, constant_radices_t<1000, 1000>());
+            else if (first_radix == 1000 && radix == 100)
+                return render_numeral_column(values, lexicon, force_leading_zero, constant_radices_t<1000, 100>());
+            else if (first_radix == 10000 && radix == 10000)
+                return render_numeral_column(values, lexicon, force_leading_zero, constant_radices_t<10000, 10000>());
+
+            return render_numeral_column(values, lexicon, force_leading_zero,
+                [&](const uint64_t value, uint32_t (&groups)[group_lexicon_t::max_groups_count]) {
+                    return split_groups(value, lexicon, groups);
+                });
+        }
+
+        /*
+         * Renders the values as German numerals, which are composed of compound words that the group lexicon does not
+         * have, one numeral after another.
+         */
+        template <typename T>
+        numeral_column_t render_german_numeral_column(const std::span<const T> values,
+                                                      const conversion_options_t &conversion_options)
+        {
+            numeral_column_t column;
+            column.offsets.resize(values.size() + 1);
+            column.offsets[0] = 0;
+
+            for (std::size_t row = 0; row < values.size(); row++)
+            {
+                const auto numeral = render_german_numeral(false, std::to_string(values[row]), {}, conversion_options);
+                column.data.insert(column.data.end(), numeral.begin(), numeral.end());
+                column.offsets[row + 1] = column.data.size();
+            }
+
+            return column;
+        }
+    }
+
+    /*
+     * Converts a column of integers to numerals at once. The numerals are the same as those of to_numeral, but they are
+     * written into one contiguous buffer instead of separate strings, which makes this considerably faster for large
+     * numbers of values. German numerals are rendered by the German engine one after another.
+     * \param values The values to be converted.
+     * \returns the column of numerals, one for each value.
+     */
+    numeral_column_t converter_c::to_numeral_column(std::span<const uint64_t> values)
+    {
+        if (is_german(_conversion_options))
+            return render_german_numeral_column(values, _conversion_options);
+
+        return render_numeral_column(values, get_group_lexicon(_conversion_options.naming_system),
+                                     _conversion_options.force_leading_zero);
+    }
+
+    numeral_column_t converter_c::to_numeral_column(std::span<const uint32_t> values)
+    {
+        if (is_german(_conversion_options))
+            return render_german_numeral_column(values, _conversion_options);
+
+        return render_numeral_column(values, get_group_lexicon(_conversion_options.naming_system),
+                                     _conversion_options.force_leading_zero);
+    }
+}
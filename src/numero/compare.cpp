@@ -0,0 +1,440 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "numero/numero.h"
+#include "german.h"
+#include "parser.h"
+
+namespace num
+{
+    void check_exponent_range(const std::string_view &number, int32_t exponent);
+
+    namespace
+    {
+        struct token_text_t
+        {
+            const std::vector<std::string_view> *tokens;
+
+            inline std::string_view operator()(const std::size_t position) const {
+                return (*tokens)[position];
+            }
+        };
+
+        /*
+         * Splits a numeral into its terms like the numeral pattern of the conversion does, i.e. into terms of either
+         * lower case letters or digits that are separated by spaces or tabs or by a single hyphen.
+         * \returns false if the numeral does not match that pattern.
+         */
+        bool split_terms(const std::string_view &numeral, std::vector<std::string_view> &terms)
+        {
+            const auto is_letter = [](const char c) { return c >= 'a' && c <= 'z'; };
+            const auto is_digit = [](const char c) { return c >= '0' && c <= '9'; };
+
+            for (std::size_t begin = 0, end; begin < numeral.size(); begin = end)
+            {
+                const auto is_term_char = is_letter(numeral[begin]) ? is_letter : is_digit;
+                for (end = begin; end < numeral.size() && is_term_char(numeral[end]); end++);
+
+                if (end == begin)
+                    return false;
+
+                terms.push_back(numeral.substr(begin, end - begin));
+
+                if (end == numeral.size())
+                    return true;
+
+                if (numeral[end] == '-')
+                    end++;
+                else
+                    for (; end < numeral.size() && (numeral[end] == ' ' || numeral[end] == '\t'); end++);
+
+                if (end == numeral.size() || end == begin + terms.back().size())
+                    return false;
+            }
+
+            return false;
+        }
+
+        /*
+         * Tells whether the input is to be treated as a numeral rather than as a number, i.e. whether it contains
+         * lower case letters other than the "e" of the scientific notation, without matching it against the number
+         * pattern first.
+         */
+        bool looks_like_numeral(const std::string_view &input)
+        {
+            return std::any_of(input.begin(), input.end(), [](const char c) { return c >= 'a' && c <= 'z' && c != 'e'; });
+        }
+
+        /*
+         * Appends the digit of a term of the fractional part of a numeral given as text, which is classified by its
+         * term identifier if it has one.
+         */
+        void append_fractional_term_by_id(const std::string_view &term, std::string &target)
+        {
+            const auto term_id = find_term_id(term);
+            if (term_id)
+                append_fractional_term(*term_id, target);
+            else
+                append_fractional_term(term, target);
+        }
+
+        inline uint64_t mix(uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        inline int compare_magnitudes(const value_magnitude_t &a, const value_magnitude_t &b)
+        {
+            if (a.sign != b.sign)
+                return a.sign < b.sign ? -1 : 1;
+
+            if (a.sign == 0 || a.exponent == b.exponent)
+                return 0;
+
+            return (a.exponent < b.exponent) == (a.sign > 0) ? -1 : 1;
+        }
+    }
+
+    /*
+     * Parses a numeral into its sign and the digits of its integral and fractional part. Terms are classified by
+     * their term identifiers and the shifts of the naming system, and the integral digits are merged from the
+     * groups of the parser, so that neither a number is formatted nor parsed again.
+     * \throws std::invalid_argument exception if the numeral is invalid, just as converting it does.
+     */
+    void parse_numeral_digits(const std::string_view &numeral, const conversion_options_t &conversion_options,
+                              bool &out_negative, std::string &out_integral_part, std::string &out_fractional_part)
+    {
+        std::vector<std::string_view> terms;
+
+        if (numeral.empty())
+            throw std::invalid_argument("the numeral must not be empty");
+
+        if (!split_terms(numeral, terms) || numeral == "negative" || numeral == "minus")
+            throw std::invalid_argument("the numeral is invalid");
+
+        const auto point = std::find(terms.begin(), terms.end(), "point");
+        if (point != terms.end())
+        {
+            if (std::next(point) == terms.end())
+                throw std::invalid_argument("\"point\" is not a valid term");
+
+            if (std::find(std::next(point), terms.end(), "point") != terms.end())
+                throw std::logic_error("\"point\" is only allowed once in a numeral as a decimal separator");
+        }
+
+        out_negative = false;
+        out_integral_part.clear();
+        out_fractional_part.clear();
+
+        if (point != terms.begin())
+        {
+            integral_number_parser_c<token_text_t> parser(conversion_options, token_text_t { &terms });
+
+            for (auto term = terms.begin(); term != point; term++)
+                push_integral_term_by_id(parser, *term, conversion_options);
+
+            out_integral_part = parser.finish_digits();
+            out_negative = parser.negative();
+        }
+
+        if (point != terms.end())
+        {
+            for (auto term = std::next(point); term != terms.end(); term++)
+                append_fractional_term_by_id(*term, out_fractional_part);
+        }
+    }
+
+    /*
+     * Extracts the significant digits of a number or numeral, so that its value is 0.<digits> * 10^<exponent>. The
+     * digits have neither leading nor trailing zeros; zero has no digits at all and is never negative. The digits of a
+     * numeral are taken from the groups of its parser rather than from the number it converts to.
+     * \throws std::invalid_argument exception if the input is neither a valid number nor a valid numeral.
+     * \throws std::out_of_range exception if the exponent of a number is out of the supported range.
+     */
+    void converter_c::extract_significant_digits(const std::string_view &input, bool &out_negative,
+                                                 int32_t &out_exponent, std::string &out_digits)
+    {
+        bool negative = false;
+        std::string integral_part;
+        std::string fractional_part;
+        int32_t exponent = 0;
+
+        if (looks_like_numeral(input) && !is_german(_conversion_options))
+        {
+            parse_numeral_digits(input, _conversion_options, negative, integral_part, fractional_part);
+        }
+        else if (extract_number_parts(input, negative, integral_part, fractional_part, exponent, false))
+        {
+            check_exponent_range(input, exponent);
+        }
+        else
+        {
+            const auto number = convert_to_number(input);
+            extract_number_parts(number, negative, integral_part, fractional_part, exponent, false);
+        }
+
+        auto digits = integral_part + fractional_part;
+        const auto leading_zeros = std::min(digits.find_first_not_of('0'), digits.size());
+        digits.erase(0, leading_zeros);
+        digits.erase(digits.find_last_not_of('0') + 1);
+
+        out_negative = negative && !digits.empty();
+        out_exponent = digits.empty() ? 0 : static_cast<int32_t>(integral_part.size()) -
+                                           static_cast<int32_t>(leading_zeros) + exponent;
+        out_digits = std::move(digits);
+    }
+
+    /*
+     * Estimates the magnitude of a numeral from its sign and its first sub numeral only, as no other sub numeral of a
+     * valid numeral can reach its places. A numeral without a non-zero integral part is estimated from the leading
+     * zeros of its fractional part.
+     * \returns false if the magnitude could not be estimated, e.g. because the numeral is invalid.
+     */
+    bool converter_c::estimate_numeral_magnitude(const std::string_view &numeral, value_magnitude_t &out_magnitude)
+    {
+        std::vector<std::string_view> terms;
+        if (!split_terms(numeral, terms) || terms.empty())
+            return false;
+
+        integral_number_parser_c<token_text_t> parser(_conversion_options, token_text_t { &terms });
+        std::size_t position = 0;
+
+        try
+        {
+            for (; position < terms.size() && terms[position] != "point"; position++)
+            {
+                push_integral_term_by_id(parser, terms[position], _conversion_options);
+
+                if (!parser.groups().empty())
+                {
+                    out_magnitude.sign = parser.negative() ? -1 : 1;
+                    out_magnitude.exponent = static_cast<int32_t>(parser.groups().front().size());
+                    return true;
+                }
+            }
+
+            if (parser.at_beginning() && position == terms.size())
+                return false;
+
+            const auto &integral = parser.current_group();
+            const auto sign = parser.negative() ? -1 : 1;
+
+            if (!integral.empty() && integral != "0")
+            {
+                out_magnitude.sign = sign;
+                out_magnitude.exponent = static_cast<int32_t>(integral.size());
+                return true;
+            }
+
+            // The integral part is zero or left out, so the magnitude is that of the fractional part.
+            int32_t exponent = 0;
+            std::string digit;
+
+            for (position++; position < terms.size(); position++, exponent--)
+            {
+                digit.clear();
+                append_fractional_term_by_id(terms[position], digit);
+
+                if (digit != "0")
+                {
+                    out_magnitude.sign = sign;
+                    out_magnitude.exponent = exponent;
+                    return true;
+                }
+            }
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+
+        out_magnitude = value_magnitude_t();
+        return true;
+    }
+
+    /*
+     * Estimates the order of magnitude of a number or numeral. Numerals are only converted as far as needed, which is
+     * their sign and their first sub numeral, e.g. "twelve million" of "twelve million eighty-three thousand fifty-six".
+     * The magnitude of an invalid numeral may be estimated nonetheless.
+     * \param input The number or numeral.
+     * \returns the magnitude of the value of the input.
+     * \throws std::invalid_argument exception if the magnitude of an invalid input can not be estimated.
+     * \throws std::out_of_range exception if the exponent of a number is out of the supported range.
+     */
+    value_magnitude_t converter_c::estimate_magnitude(const std::string_view &input)
+    {
+        value_magnitude_t magnitude;
+
+        if (looks_like_numeral(input) && !is_german(_conversion_options) &&
+            estimate_numeral_magnitude(input, magnitude))
+            return magnitude;
+
+        bool negative;
+        std::string digits;
+        extract_significant_digits(input, negative, magnitude.exponent, digits);
+        magnitude.sign = digits.empty() ? 0 : negative ? -1 : 1;
+        return magnitude;
+    }
+
+    /*
+     * Compares the values of two inputs, each of which may be a number or a numeral. Signs and magnitudes are compared
+     * first, so that inputs of different magnitudes are ordered without converting them completely; only inputs of the
+     * same magnitude are converted and compared digit by digit. Hence, an invalid numeral may be ordered without error.
+     * \param a The first number or numeral.
+     * \param b The second number or numeral.
+     * \returns a negative value if a is less than b, zero if both are equal and a positive value otherwise.
+     * \throws std::invalid_argument exception if an input that has to be converted is invalid.
+     * \throws std::out_of_range exception if the exponent of a number is out of the supported range.
+     */
+    int converter_c::compare_values(const std::string_view &a, const std::string_view &b)
+    {
+        const auto magnitude_order = compare_magnitudes(estimate_magnitude(a), estimate_magnitude(b));
+        if (magnitude_order != 0)
+            return magnitude_order;
+
+        bool a_negative, b_negative;
+        int32_t a_exponent, b_exponent;
+        std::string a_digits, b_digits;
+        extract_significant_digits(a, a_negative, a_exponent, a_digits);
+        extract_significant_digits(b, b_negative, b_exponent, b_digits);
+
+        const auto order = compare_magnitudes({ a_digits.empty() ? 0 : a_negative ? -1 : 1, a_exponent },
+                                              { b_digits.empty() ? 0 : b_negative ? -1 : 1, b_exponent });
+        if (order != 0 || a_digits.empty())
+            return order;
+
+        const auto digits_order = a_digits.compare(b_digits);
+        return digits_order == 0 ? 0 : (digits_order < 0) != a_negative ? -1 : 1;
+    }
+
+    /*
+     * Compares the value of an input against a value whose significant digits have been extracted before, e.g. a bound
+     * that many inputs are compared against. As with two inputs, the input is only converted completely if its
+     * magnitude equals that of the value.
+     * \param a The number or numeral.
+     * \param b The significant digits of the value to compare against.
+     * \returns a negative value if a is less than b, zero if both are equal and a positive value otherwise.
+     * \throws std::invalid_argument exception if the input has to be converted and is invalid.
+     */
+    int converter_c::compare_values(const std::string_view &a, const value_digits_t &b)
+    {
+        const value_magnitude_t b_magnitude = { b.digits.empty() ? 0 : b.negative ? -1 : 1, b.exponent };
+
+        const auto magnitude_order = compare_magnitudes(estimate_magnitude(a), b_magnitude);
+        if (magnitude_order != 0)
+            return magnitude_order;
+
+        bool a_negative;
+        int32_t a_exponent;
+        std::string a_digits;
+        extract_significant_digits(a, a_negative, a_exponent, a_digits);
+
+        const auto order = compare_magnitudes({ a_digits.empty() ? 0 : a_negative ? -1 : 1, a_exponent }, b_magnitude);
+        if (order != 0 || a_digits.empty())
+            return order;
+
+        const auto digits_order = a_digits.compare(b.digits);
+        return digits_order == 0 ? 0 : (digits_order < 0) != a_negative ? -1 : 1;
+    }
+
+    /*
+     * Gets the significant digits of a number or numeral.
+     * \param input The number or numeral.
+     * \returns the sign, exponent and significant digits of the value of the input.
+     * \throws std::invalid_argument exception if the input is invalid.
+     * \throws std::out_of_range exception if the exponent of a number is out of the supported range.
+     */
+    value_digits_t converter_c::significant_digits(const std::string_view &input)
+    {
+        value_digits_t value;
+        extract_significant_digits(input, value.negative, value.exponent, value.digits);
+        return value;
+    }
+
+    /*
+     * Gets the binary sort key of a number or numeral. The key consists of a sign byte, the biased exponent in two
+     * bytes and the first 26 significant digits in packed decimal, with all but the sign byte inverted for negative
+     * values, so that larger magnitudes sort first among them.
+     * \param input The number or numeral.
+     * \returns the sort key of the value of the input.
+     * \throws std::invalid_argument exception if the input is invalid.
+     * \throws std::out_of_range exception if the exponent of a number is out of the supported range.
+     */
+    sort_key_t converter_c::sort_key(const std::string_view &input)
+    {
+        bool negative;
+        int32_t exponent;
+        std::string digits;
+        extract_significant_digits(input, negative, exponent, digits);
+
+        sort_key_t key {};
+        key[0] = digits.empty() ? 1 : negative ? 0 : 2;
+
+        if (digits.empty())
+            return key;
+
+        const auto biased_exponent = static_cast<uint16_t>(std::clamp<int32_t>(exponent, -32768, 32767) + 32768);
+        key[1] = static_cast<uint8_t>(biased_exponent >> 8);
+        key[2] = static_cast<uint8_t>(biased_exponent);
+
+        const auto digits_count = std::min<std::size_t>(digits.size(), 2 * (key.size() - 3));
+        for (std::size_t i = 0; i < digits_count; i++)
+            key[3 + i / 2] |= static_cast<uint8_t>(digits[i] - '0') << (i % 2 == 0 ? 4 : 0);
+
+        if (negative)
+        {
+            for (std::size_t i = 1; i < key.size(); i++)
+                key[i] = static_cast<uint8_t>(~key[i]);
+        }
+
+        return key;
+    }
+
+    /*
+     * Hashes the value of a number or numeral, so that equal values get the same hash regardless of their surface form,
+     * e.g. "one thousand million", "one billion", "1,000,000,000" and "1e9". The hash is computed from the sign, the
+     * exponent and the significant digits of the value, which are consumed eight at a time as 64-bit words. The digits
+     * of a numeral are merged once from the digit groups of its parser, without converting it to a number; the digits
+     * of a number are taken from its text without the separators.
+     * \param input The number or numeral.
+     * \returns the 64-bit hash of the value of the input.
+     * \throws std::invalid_argument exception if the input is invalid.
+     * \throws std::out_of_range exception if the exponent of a number is out of the supported range, as values beyond
+     * it would otherwise hash equal.
+     */
+    uint64_t converter_c::value_hash(const std::string_view &input)
+    {
+        bool negative;
+        int32_t exponent;
+        std::string digits;
+        extract_significant_digits(input, negative, exponent, digits);
+
+        uint64_t hash = mix((static_cast<uint64_t>(negative) << 63) ^ (static_cast<uint64_t>(digits.size()) << 32) ^
+                            static_cast<uint32_t>(exponent));
+
+        std::size_t position = 0;
+        for (; position + 8 <= digits.size(); position += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, digits.data() + position, 8);
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+            hash ^= hash >> 29;
+        }
+
+        if (position < digits.size())
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, digits.data() + position, digits.size() - position);
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+        }
+
+        return mix(hash);
+    }
+}
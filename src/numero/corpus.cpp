@@ -0,0 +1,271 @@
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NUMERO_USE_MMAP 1
+#endif
+
+#include "numero/corpus.h"
+
+namespace num
+{
+    /*
+     * 64-bit FNV-1a hash that can be continued over several pieces of data.
+     */
+    static uint64_t fnv1a(const void *data, const std::size_t size, uint64_t hash = 0xcbf29ce484222325)
+    {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 0x100000001b3;
+        return hash;
+    }
+
+    static void throw_io_error(const char *what, const std::string &path)
+    {
+        const auto message = boost::format("unable to %1% corpus file \"%2%\": %3%") % what % path
+                                           % std::strerror(errno);
+        throw std::runtime_error(message.str());
+    }
+
+    corpus_writer_c::corpus_writer_c(const std::string &path, const std::string_view &options) :
+        _path(path),
+        _offsets_path(path + ".offsets"),
+        _header()
+    {
+        _file = std::fopen(_path.c_str(), "wb");
+        if (!_file)
+            throw_io_error("create", _path);
+
+        _offsets_file = std::fopen(_offsets_path.c_str(), "wb+");
+        if (!_offsets_file)
+        {
+            std::fclose(_file);
+            throw_io_error("create", _offsets_path);
+        }
+
+        std::memcpy(_header.magic, corpus_magic, sizeof(corpus_magic));
+        _header.version = corpus_version;
+        _header.byte_order = corpus_byte_order;
+
+        // The header is written once more when closing, as only then its sizes and checksum are known.
+        write(_file, &_header, sizeof(_header));
+        _position = sizeof(_header);
+
+        _header.options_offset = _position;
+        _header.options_size = options.size();
+        write(_file, options.data(), options.size());
+        _position += options.size();
+        _checksum = fnv1a(options.data(), options.size());
+
+        pad(_file, _position);
+        _header.blob_offset = _position;
+
+        const uint64_t first_offset = 0;
+        write(_offsets_file, &first_offset, sizeof(first_offset));
+    }
+
+    corpus_writer_c::~corpus_writer_c()
+    {
+        try
+        {
+            close();
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+
+    void corpus_writer_c::append(const std::string_view &input)
+    {
+        write(_file, input.data(), input.size());
+        _checksum = fnv1a(input.data(), input.size(), _checksum);
+        _header.blob_size += input.size();
+        _header.count++;
+
+        write(_offsets_file, &_header.blob_size, sizeof(_header.blob_size));
+    }
+
+    void corpus_writer_c::close()
+    {
+        if (!_file)
+            return;
+
+        _position += _header.blob_size;
+        pad(_file, _position);
+        _header.offsets_offset = _position;
+
+        // Copy the spooled offsets behind the blob.
+        std::rewind(_offsets_file);
+
+        char buffer[65536];
+        for (std::size_t read; (read = std::fread(buffer, 1, sizeof(buffer), _offsets_file)) > 0;)
+        {
+            write(_file, buffer, read);
+            _checksum = fnv1a(buffer, read, _checksum);
+        }
+
+        _header.checksum = _checksum;
+
+        std::fseek(_file, 0, SEEK_SET);
+        write(_file, &_header, sizeof(_header));
+
+        const auto closed = std::fclose(_file) == 0;
+        _file = nullptr;
+
+        std::fclose(_offsets_file);
+        _offsets_file = nullptr;
+        std::remove(_offsets_path.c_str());
+
+        if (!closed)
+            throw_io_error("write", _path);
+    }
+
+    void corpus_writer_c::write(std::FILE *file, const void *data, const std::size_t size)
+    {
+        if (size > 0 && std::fwrite(data, 1, size, file) != size)
+            throw_io_error("write", file == _file ? _path : _offsets_path);
+    }
+
+    void corpus_writer_c::pad(std::FILE *file, uint64_t &position)
+    {
+        static const char zeros[8] = {};
+        const auto padding = (8 - position % 8) % 8;
+        write(file, zeros, padding);
+        position += padding;
+    }
+
+    /*
+     * Opens and maps the given corpus file into memory.
+     *
+     * \param path The path of the corpus file.
+     * \param verify_checksum Whether to verify the checksum and the offset table of the corpus, which requires reading
+     *   the whole file. Corpora from untrusted sources should always be verified.
+     * \throws std::runtime_error exception if the file cannot be read or is not a valid corpus.
+     */
+    corpus_c::corpus_c(const std::string &path, bool verify_checksum)
+    {
+#ifdef NUMERO_USE_MMAP
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw_io_error("open", path);
+
+        struct stat status;
+        if (::fstat(fd, &status) != 0)
+        {
+            ::close(fd);
+            throw_io_error("open", path);
+        }
+
+        _size = static_cast<std::size_t>(status.st_size);
+        if (_size > 0)
+        {
+            auto *mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                ::close(fd);
+                throw_io_error("map", path);
+            }
+            _data = static_cast<const char *>(mapping);
+        }
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw_io_error("open", path);
+
+        _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        _data = _buffer.data();
+        _size = _buffer.size();
+#endif
+
+        const auto throw_invalid = [&](const char *reason) {
+            release();
+            const auto message = boost::format("\"%1%\" is not a valid corpus file: %2%") % path % reason;
+            throw std::runtime_error(message.str());
+        };
+
+        if (_size < sizeof(corpus_header_t) || std::memcmp(_data, corpus_magic, sizeof(corpus_magic)) != 0)
+            throw_invalid("missing header");
+
+        const auto *header = reinterpret_cast<const corpus_header_t *>(_data);
+        if (header->version != corpus_version)
+            throw_invalid("unsupported version");
+        if (header->byte_order != corpus_byte_order)
+            throw_invalid("written on a host with a different byte order");
+
+        // Sizes are compared against the remaining size behind their offset, so that corrupt headers cannot overflow.
+        const auto fits = [&](const uint64_t offset, const uint64_t size) {
+            return offset <= _size && size <= _size - offset;
+        };
+
+        if (!fits(header->options_offset, header->options_size) ||
+            !fits(header->blob_offset, header->blob_size) ||
+            header->offsets_offset % sizeof(uint64_t) != 0 ||
+            header->count >= _size / sizeof(uint64_t) ||
+            !fits(header->offsets_offset, (header->count + 1) * sizeof(uint64_t)))
+            throw_invalid("truncated");
+
+        const auto offsets_size = (header->count + 1) * sizeof(uint64_t);
+
+        _header = header;
+        _blob = _data + header->blob_offset;
+        _offsets = reinterpret_cast<const uint64_t *>(_data + header->offsets_offset);
+
+        if (verify_checksum)
+        {
+            auto checksum = fnv1a(_data + header->options_offset, header->options_size);
+            checksum = fnv1a(_blob, header->blob_size, checksum);
+            checksum = fnv1a(_offsets, offsets_size, checksum);
+
+            if (checksum != header->checksum)
+                throw_invalid("checksum mismatch");
+
+            for (uint64_t i = 0; i < header->count; i++)
+            {
+                if (_offsets[i] > _offsets[i + 1] || _offsets[i + 1] > header->blob_size)
+                    throw_invalid("corrupt offset table");
+            }
+        }
+    }
+
+    void corpus_c::throw_corrupt_offsets(const std::size_t index) const
+    {
+        const auto message = boost::format("corrupt offset table: input %1% spans from %2% to %3% in a blob of %4% "
+                                           "bytes") % index % _offsets[index] % _offsets[index + 1]
+                                           % _header->blob_size;
+        throw std::runtime_error(message.str());
+    }
+
+    corpus_c::~corpus_c()
+    {
+        release();
+    }
+
+    void corpus_c::release()
+    {
+#ifdef NUMERO_USE_MMAP
+        if (_data && _buffer.empty())
+            ::munmap(const_cast<char *>(_data), _size);
+#endif
+        _data = nullptr;
+        _size = 0;
+        _header = nullptr;
+    }
+
+    /*
+     * Checks whether the given file starts like a binary corpus file.
+     */
+    bool corpus_c::is_corpus(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        char magic[sizeof(corpus_magic)] = {};
+        return file.read(magic, sizeof(magic)) && std::memcmp(magic, corpus_magic, sizeof(corpus_magic)) == 0;
+    }
+}
@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "numero/digit_grouping.h"
+
+namespace num
+{
+    namespace
+    {
+        /*
+         * Size of the least significant group and of all further groups of a digit grouping.
+         */
+        struct group_sizes_t
+        {
+            std::size_t first;
+            std::size_t rest;
+        };
+
+        constexpr group_sizes_t get_group_sizes(const digit_grouping_t grouping)
+        {
+            switch (grouping)
+            {
+            case digit_grouping_t::indian:
+                return { 3, 2 };
+            case digit_grouping_t::myriad:
+                return { 4, 4 };
+            default:
+                return { 3, 3 };
+            }
+        }
+
+        std::size_t separators_count(const std::size_t digits_count, const group_sizes_t group_sizes)
+        {
+            return digits_count <= group_sizes.first ? 0 : 1 + (digits_count - group_sizes.first - 1) / group_sizes.rest;
+        }
+
+        /*
+         * Writes the digits that end at the given position grouped right to left, so that the grouped digits end at the
+         * given target position. Digits and target may overlap as long as the target does not end before the digits,
+         * which allows grouping in place: every group is moved at most as far to the right as the separators behind it
+         * take, and so never overwrites digits that are yet to be moved.
+         */
+        void write_grouped_digits(const char *digits_end, std::size_t digits_count, char *target_end,
+                                  const std::string_view &separator, const group_sizes_t group_sizes)
+        {
+            auto group_size = group_sizes.first;
+
+            while (digits_count > group_size)
+            {
+                digits_end -= group_size;
+                target_end -= group_size;
+                std::memmove(target_end, digits_end, group_size);
+
+                target_end -= separator.size();
+                std::memcpy(target_end, separator.data(), separator.size());
+
+                digits_count -= group_size;
+                group_size = group_sizes.rest;
+            }
+
+            std::memmove(target_end - digits_count, digits_end - digits_count, digits_count);
+        }
+    }
+
+    std::size_t grouped_digits_size(const std::size_t digits_count, const std::size_t separator_size,
+                                    const digit_grouping_t grouping)
+    {
+        return digits_count + separators_count(digits_count, get_group_sizes(grouping)) * separator_size;
+    }
+
+    void append_grouped_digits(const std::string_view &digits, const std::string_view &separator,
+                               const digit_grouping_t grouping, std::string &target)
+    {
+        const auto offset = target.size();
+        target.resize(offset + grouped_digits_size(digits.size(), separator.size(), grouping));
+        write_grouped_digits(digits.data() + digits.size(), digits.size(), target.data() + target.size(), separator,
+                             get_group_sizes(grouping));
+    }
+
+    std::string group_digits(const std::string_view &digits, const std::string_view &separator,
+                             const digit_grouping_t grouping)
+    {
+        std::string result;
+        append_grouped_digits(digits, separator, grouping, result);
+        return result;
+    }
+
+    void group_digits_in_place(std::string &target, const std::string_view &separator,
+                               const digit_grouping_t grouping)
+    {
+        const auto digits_count = target.size();
+        const auto grouped_size = grouped_digits_size(digits_count, separator.size(), grouping);
+        if (grouped_size == digits_count)
+            return;
+
+        target.resize(grouped_size);
+        write_grouped_digits(target.data() + digits_count, digits_count, target.data() + grouped_size, separator,
+                             get_group_sizes(grouping));
+    }
+}
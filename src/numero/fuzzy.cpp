@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    namespace
+    {
+        constexpr std::size_t max_term_size = 32;
+
+        /*
+         * Computes the Levenshtein distance of two terms, but gives up as soon as it exceeds the given maximum.
+         * \returns the distance, or max_distance + 1 if it is greater than max_distance.
+         */
+        uint32_t bounded_edit_distance(const std::string_view &a, const std::string_view &b, const uint32_t max_distance)
+        {
+            const auto size_difference = a.size() > b.size() ? a.size() - b.size() : b.size() - a.size();
+            if (size_difference > max_distance || a.size() > max_term_size || b.size() > max_term_size)
+                return max_distance + 1;
+
+            std::array<uint32_t, max_term_size + 1> previous_row, current_row;
+            for (std::size_t j = 0; j <= b.size(); j++)
+                previous_row[j] = static_cast<uint32_t>(j);
+
+            for (std::size_t i = 1; i <= a.size(); i++)
+            {
+                current_row[0] = static_cast<uint32_t>(i);
+                auto row_minimum = current_row[0];
+
+                for (std::size_t j = 1; j <= b.size(); j++)
+                {
+                    current_row[j] = std::min({ previous_row[j] + 1, current_row[j - 1] + 1,
+                                                previous_row[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1) });
+                    row_minimum = std::min(row_minimum, current_row[j]);
+                }
+
+                if (row_minimum > max_distance)
+                    return max_distance + 1;
+
+                std::swap(previous_row, current_row);
+            }
+
+            return std::min(previous_row[b.size()], max_distance + 1);
+        }
+
+        /*
+         * BK-tree of all terms of the lexicon. Each child edge is labeled with the edit distance between parent and child,
+         * so that by the triangle inequality a query only descends into children whose label is within the maximum
+         * distance of the distance between query and parent. The tree is built once, and as the lexicon is fixed, every
+         * query is bounded by its size.
+         */
+        class term_tree_c
+        {
+        public:
+            term_tree_c()
+            {
+                for (std::size_t term = 0; term < terms_count; term++)
+                    insert(term_text(static_cast<term_id_t>(term)));
+            }
+
+            /*
+             * Finds the term closest to the given text within the maximum distance.
+             * \returns false if there is none or if there are several equally close ones.
+             */
+            bool find_closest(const std::string_view &text, const uint32_t max_distance, std::string_view &out_term,
+                              uint32_t &out_distance) const
+            {
+                auto best_distance = max_distance + 1;
+                bool ambiguous = false;
+                std::vector<std::size_t> pending = { 0 };
+
+                while (!pending.empty())
+                {
+                    const auto &node = _nodes[pending.back()];
+                    pending.pop_back();
+
+                    const auto distance = bounded_edit_distance(text, node.term, max_term_size);
+
+                    if (distance < best_distance)
+                    {
+                        best_distance = distance;
+                        out_term = node.term;
+                        ambiguous = false;
+                    }
+                    else if (distance == best_distance)
+                    {
+                        ambiguous = true;
+                    }
+
+                    for (const auto &[edge_distance, child] : node.children)
+                    {
+                        if (edge_distance + max_distance >= distance && edge_distance <= distance + max_distance)
+                            pending.push_back(child);
+                    }
+                }
+
+                out_distance = best_distance;
+                return best_distance <= max_distance && !ambiguous;
+            }
+
+        private:
+            struct node_t
+            {
+                std::string_view term;
+                std::vector<std::pair<uint32_t, std::size_t>> children;
+            };
+
+            void insert(const std::string_view &term)
+            {
+                if (_nodes.empty())
+                {
+                    _nodes.push_back({ term, {} });
+                    return;
+                }
+
+                for (std::size_t index = 0;;)
+                {
+                    const auto distance = bounded_edit_distance(term, _nodes[index].term, max_term_size);
+                    auto &children = _nodes[index].children;
+                    const auto child = std::find_if(children.begin(), children.end(),
+                                                    [&](const auto &edge) { return edge.first == distance; });
+
+                    if (child == children.end())
+                    {
+                        children.emplace_back(distance, _nodes.size());
+                        _nodes.push_back({ term, {} });
+                        return;
+                    }
+
+                    index = child->second;
+                }
+            }
+
+        private:
+            std::vector<node_t> _nodes;
+        };
+
+        const term_tree_c &get_term_tree()
+        {
+            static const term_tree_c term_tree;
+            return term_tree;
+        }
+    }
+
+    /*
+     * Replaces unknown terms of a numeral by the closest terms of the lexicon, if the maximum number of edits of the
+     * conversion options allows for it. A term is only replaced if there is exactly one closest term and if the number
+     * of edits is at most a third of its size, so that short terms such as "to" are never replaced.
+     * \param numeral The numeral whose terms are to be corrected.
+     * \param corrections The vector that receives the corrections made.
+     * \returns the numeral with corrected terms; the numeral itself if no term was corrected.
+     */
+    std::string converter_c::correct_terms(const std::string_view &numeral, std::vector<term_correction_t> &corrections)
+    {
+        std::string corrected_numeral(numeral);
+
+        if (_conversion_options.max_term_edits == 0)
+            return corrected_numeral;
+
+        const auto is_separator = [](const char c) { return c == ' ' || c == '\t' || c == '-'; };
+        const auto is_lower = [](const char c) { return c >= 'a' && c <= 'z'; };
+
+        // Terms are replaced from the end, so that the positions of the terms in front stay valid.
+        std::vector<term_correction_t> found_corrections;
+
+        for (std::size_t begin = 0, end; begin < numeral.size(); begin = end)
+        {
+            for (; begin < numeral.size() && is_separator(numeral[begin]); begin++);
+            for (end = begin; end < numeral.size() && !is_separator(numeral[end]); end++);
+
+            const auto term = numeral.substr(begin, end - begin);
+            const auto max_edits = std::min<uint32_t>(_conversion_options.max_term_edits,
+                                                      static_cast<uint32_t>(term.size() / 3));
+
+            if (max_edits == 0 || !std::all_of(term.begin(), term.end(), is_lower) || find_term_id(term))
+                continue;
+
+            std::string_view correction;
+            uint32_t edits;
+
+            if (get_term_tree().find_closest(term, max_edits, correction, edits))
+                found_corrections.push_back({ std::string(term), correction, edits, begin });
+        }
+
+        for (auto it = found_corrections.rbegin(); it != found_corrections.rend(); it++)
+            corrected_numeral.replace(it->position, it->term.size(), it->correction);
+
+        corrections.insert(corrections.end(), found_corrections.begin(), found_corrections.end());
+        return corrected_numeral;
+    }
+}
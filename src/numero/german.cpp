@@ -0,0 +1,676 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "german.h"
+
+namespace num
+{
+    void add_thousands_separators(std::string &target, char thousands_separator_symbol);
+
+    namespace
+    {
+        /*
+         * The greatest scale word is "Dezilliarde", i.e. 10^63, so that numbers have at most 66 integral places.
+         */
+        constexpr std::size_t max_scale_factor = 10;
+        constexpr std::size_t max_integral_places = 6 * max_scale_factor + 6;
+        constexpr std::size_t max_groups_count = max_integral_places / 3;
+
+        /*
+         * Words longer than this can not be numeral terms; even "siebenhundertsiebenundsiebzigtausendsiebenhundert-
+         * siebenundsiebzig" is only half as long.
+         */
+        constexpr std::size_t max_word_size = 160;
+
+        constexpr std::string_view unit_texts[10] = { "null", "eins", "zwei", "drei", "vier", "fünf", "sechs", "sieben",
+                                                      "acht", "neun" };
+        constexpr std::string_view teen_texts[10] = { "zehn", "elf", "zwölf", "dreizehn", "vierzehn", "fünfzehn",
+                                                      "sechzehn", "siebzehn", "achtzehn", "neunzehn" };
+        constexpr std::string_view ten_texts[10] = { "", "zehn", "zwanzig", "dreißig", "vierzig", "fünfzig", "sechzig",
+                                                     "siebzig", "achtzig", "neunzig" };
+        constexpr std::string_view scale_prefixes[max_scale_factor] = { "M", "B", "Tr", "Quadr", "Quint", "Sext",
+                                                                        "Sept", "Okt", "Non", "Dez" };
+
+        /*
+         * Kinds of morphemes that German numeral words are composed of. "ein" links a one to a following "und",
+         * "hundert" or "tausend", while "eins" ends a numeral and "eine" precedes a feminine scale word.
+         */
+        enum class morpheme_kind_t : uint8_t
+        {
+            none = 0,
+            zero,
+            one_linking,
+            one_final,
+            one_feminine,
+            unit,
+            teen,
+            ten,
+            und,
+            hundred,
+            thousand,
+            scale,
+            minus,
+            comma
+        };
+
+        struct morpheme_t
+        {
+            std::string text;
+            morpheme_kind_t kind = morpheme_kind_t::none;
+            uint32_t value = 0;
+        };
+
+        /*
+         * Maps the bytes of lower and upper case letters, including the UTF-8 encoded umlauts and ß, to the symbols of
+         * the trie; other bytes are mapped to -1.
+         */
+        constexpr std::size_t symbols_count = 31;
+
+        constexpr std::array<int8_t, 256> symbols = []() {
+            std::array<int8_t, 256> symbols = {};
+            std::fill(symbols.begin(), symbols.end(), static_cast<int8_t>(-1));
+
+            for (int c = 0; c < 26; c++)
+            {
+                symbols['a' + c] = static_cast<int8_t>(c);
+                symbols['A' + c] = static_cast<int8_t>(c);
+            }
+
+            // Lead byte of ä, ö, ü and ß, followed by the trail bytes of their lower and upper case forms.
+            symbols[0xC3] = 26;
+            symbols[0xA4] = symbols[0x84] = 27;
+            symbols[0xB6] = symbols[0x96] = 28;
+            symbols[0xBC] = symbols[0x9C] = 29;
+            symbols[0x9F] = 30;
+            return symbols;
+        }();
+
+        inline int8_t symbol(const char c)
+        {
+            return symbols[static_cast<uint8_t>(c)];
+        }
+
+        /*
+         * Lexicon of all German morphemes in a trie. German writes numerals below one million as single compound words,
+         * e.g. "dreihundertfünfundzwanzigtausend", so words are segmented into morphemes instead of being looked up as
+         * a whole. The segmentation walks the trie from every position that a morpheme ends at; as morphemes are short,
+         * this takes linear time in the size of the word.
+         */
+        class german_lexicon_c
+        {
+        public:
+            german_lexicon_c()
+            {
+                _nodes.emplace_back();
+
+                add("null", morpheme_kind_t::zero, 0);
+                add("ein", morpheme_kind_t::one_linking, 1);
+                add("eins", morpheme_kind_t::one_final, 1);
+                add("eine", morpheme_kind_t::one_feminine, 1);
+
+                for (uint32_t i = 2; i < 10; i++)
+                    add(unit_texts[i], morpheme_kind_t::unit, i);
+
+                for (uint32_t i = 0; i < 10; i++)
+                    add(teen_texts[i], morpheme_kind_t::teen, 10 + i);
+
+                for (uint32_t i = 2; i < 10; i++)
+                    add(ten_texts[i], morpheme_kind_t::ten, 10 * i);
+
+                // Swiss spelling without ß.
+                add("dreissig", morpheme_kind_t::ten, 30);
+
+                add("und", morpheme_kind_t::und, 0);
+                add("hundert", morpheme_kind_t::hundred, 100);
+                add("tausend", morpheme_kind_t::thousand, 1000);
+                add("minus", morpheme_kind_t::minus, 0);
+                add("komma", morpheme_kind_t::comma, 0);
+
+                // Long scale: "Million" is 10^6, "Milliarde" 10^9, "Billion" 10^12, "Billiarde" 10^15 and so on.
+                for (std::size_t factor = 1; factor <= max_scale_factor; factor++)
+                {
+                    const auto prefix = std::string(scale_prefixes[factor - 1]);
+                    const auto place = static_cast<uint32_t>(6 * factor);
+                    add(prefix + "illion", morpheme_kind_t::scale, place);
+                    add(prefix + "illionen", morpheme_kind_t::scale, place);
+                    add(prefix + "illiarde", morpheme_kind_t::scale, place + 3);
+                    add(prefix + "illiarden", morpheme_kind_t::scale, place + 3);
+                }
+            }
+
+            /*
+             * Segments a word into the fewest morphemes, e.g. "dreizehn" into "dreizehn" rather than "drei" and
+             * "zehn", regardless of the case of its letters.
+             * \returns false if the word can not be segmented into morphemes at all.
+             */
+            bool segment(const std::string_view &word, std::vector<const morpheme_t *> &out_morphemes) const
+            {
+                out_morphemes.clear();
+
+                if (word.empty() || word.size() > max_word_size)
+                    return false;
+
+                constexpr uint8_t unreachable = 0xFF;
+                std::array<uint8_t, max_word_size + 1> counts;
+                std::array<uint8_t, max_word_size + 1> starts;
+                std::array<int16_t, max_word_size + 1> ends;
+                std::fill_n(counts.begin(), word.size() + 1, unreachable);
+                counts[0] = 0;
+
+                for (std::size_t i = 0; i < word.size(); i++)
+                {
+                    if (counts[i] == unreachable)
+                        continue;
+
+                    uint32_t node = 0;
+                    for (auto j = i; j < word.size(); j++)
+                    {
+                        const auto s = symbol(word[j]);
+                        if (s < 0)
+                            return false;
+
+                        node = _nodes[node].children[s];
+                        if (node == 0)
+                            break;
+
+                        const auto morpheme = _nodes[node].morpheme;
+                        if (morpheme >= 0 && counts[i] + 1 < counts[j + 1])
+                        {
+                            counts[j + 1] = static_cast<uint8_t>(counts[i] + 1);
+                            starts[j + 1] = static_cast<uint8_t>(i);
+                            ends[j + 1] = morpheme;
+                        }
+                    }
+                }
+
+                if (counts[word.size()] == unreachable)
+                    return false;
+
+                for (auto end = word.size(); end > 0; end = starts[end])
+                    out_morphemes.push_back(&_morphemes[ends[end]]);
+
+                std::reverse(out_morphemes.begin(), out_morphemes.end());
+                return true;
+            }
+
+            inline const std::vector<morpheme_t> &morphemes() const {
+                return _morphemes;
+            }
+
+        private:
+            void add(const std::string_view &text, const morpheme_kind_t kind, const uint32_t value)
+            {
+                uint32_t node = 0;
+                for (const auto c : text)
+                {
+                    const auto s = symbol(c);
+                    if (_nodes[node].children[s] == 0)
+                    {
+                        _nodes[node].children[s] = static_cast<uint16_t>(_nodes.size());
+                        _nodes.emplace_back();
+                    }
+                    node = _nodes[node].children[s];
+                }
+
+                _nodes[node].morpheme = static_cast<int16_t>(_morphemes.size());
+                _morphemes.push_back({ std::string(text), kind, value });
+            }
+
+        private:
+            struct node_t
+            {
+                std::array<uint16_t, symbols_count> children = {};
+                int16_t morpheme = -1;
+            };
+
+            std::vector<node_t> _nodes;
+            std::vector<morpheme_t> _morphemes;
+        };
+
+        const german_lexicon_c &get_german_lexicon()
+        {
+            static const german_lexicon_c german_lexicon;
+            return german_lexicon;
+        }
+
+        inline morpheme_kind_t kind_at(const std::vector<const morpheme_t *> &morphemes, const std::size_t position)
+        {
+            return position < morphemes.size() ? morphemes[position]->kind : morpheme_kind_t::none;
+        }
+
+        /*
+         * Parses a group of a compound below one thousand, e.g. "dreihundertfünfundzwanzig", from the given position
+         * on.
+         * \returns the position after the group, which is the given position if there is no group.
+         */
+        std::size_t parse_group(const std::vector<const morpheme_t *> &morphemes, std::size_t position,
+                                uint32_t &out_value)
+        {
+            out_value = 0;
+
+            const auto kind = kind_at(morphemes, position);
+
+            if ((kind == morpheme_kind_t::unit || kind == morpheme_kind_t::one_linking) &&
+                kind_at(morphemes, position + 1) == morpheme_kind_t::hundred)
+            {
+                out_value = morphemes[position]->value * 100;
+                position += 2;
+            }
+            else if (kind == morpheme_kind_t::hundred)
+            {
+                out_value = 100;
+                position++;
+            }
+
+            switch (kind_at(morphemes, position))
+            {
+            case morpheme_kind_t::unit:
+            case morpheme_kind_t::one_linking:
+                if (kind_at(morphemes, position + 1) == morpheme_kind_t::und &&
+                    kind_at(morphemes, position + 2) == morpheme_kind_t::ten)
+                {
+                    out_value += morphemes[position]->value + morphemes[position + 2]->value;
+                    position += 3;
+                }
+                else if (kind_at(morphemes, position) == morpheme_kind_t::unit ||
+                         kind_at(morphemes, position + 1) == morpheme_kind_t::thousand)
+                {
+                    out_value += morphemes[position]->value;
+                    position++;
+                }
+                break;
+            case morpheme_kind_t::one_final:
+            case morpheme_kind_t::one_feminine:
+                if (position + 1 == morphemes.size())
+                {
+                    out_value += 1;
+                    position++;
+                }
+                break;
+            case morpheme_kind_t::teen:
+            case morpheme_kind_t::ten:
+                out_value += morphemes[position]->value;
+                position++;
+                break;
+            default:
+                break;
+            }
+
+            return position;
+        }
+
+        /*
+         * Parses a compound below one million, e.g. "zweitausendeins", or "null".
+         * \returns false if the morphemes do not form such a compound.
+         */
+        bool parse_compound(const std::vector<const morpheme_t *> &morphemes, uint32_t &out_value)
+        {
+            if (morphemes.size() == 1 && morphemes.front()->kind == morpheme_kind_t::zero)
+            {
+                out_value = 0;
+                return true;
+            }
+
+            uint32_t high;
+            auto position = parse_group(morphemes, 0, high);
+
+            if (kind_at(morphemes, position) == morpheme_kind_t::thousand)
+            {
+                // A leading "tausend" is one thousand, e.g. "tausendeins".
+                out_value = (position == 0 ? 1 : high) * 1000;
+
+                uint32_t low;
+                position = parse_group(morphemes, position + 1, low);
+                out_value += low;
+            }
+            else
+            {
+                out_value = high;
+            }
+
+            return position > 0 && position == morphemes.size();
+        }
+
+        void append_group(const uint32_t value, const std::string_view &one, std::string &numeral)
+        {
+            const auto hundreds = value / 100;
+            const auto rest = value % 100;
+
+            if (hundreds > 0)
+            {
+                numeral += hundreds == 1 ? "ein" : unit_texts[hundreds];
+                numeral += "hundert";
+            }
+
+            if (rest >= 20)
+            {
+                if (rest % 10 > 0)
+                {
+                    numeral += rest % 10 == 1 ? "ein" : unit_texts[rest % 10];
+                    numeral += "und";
+                }
+                numeral += ten_texts[rest / 10];
+            }
+            else if (rest >= 10)
+                numeral += teen_texts[rest - 10];
+            else if (rest == 1)
+                numeral += one;
+            else if (rest > 0)
+                numeral += unit_texts[rest];
+        }
+
+        void append_compound(const uint32_t value, std::string &numeral)
+        {
+            if (value >= 1000)
+            {
+                append_group(value / 1000, "ein", numeral);
+                numeral += "tausend";
+            }
+
+            append_group(value % 1000, "eins", numeral);
+        }
+
+        uint32_t group_value(const std::string_view &integral, const std::size_t group)
+        {
+            if (3 * group >= integral.size())
+                return 0;
+
+            const auto end = integral.size() - 3 * group;
+            const auto begin = end >= 3 ? end - 3 : 0;
+
+            uint32_t value = 0;
+            for (auto i = begin; i < end; i++)
+                value = value * 10 + static_cast<uint32_t>(integral[i] - '0');
+            return value;
+        }
+    }
+
+    /*
+     * Checks whether the given input has the shape of a German numeral, i.e. words of letters, including umlauts and ß,
+     * separated by spaces or tabs. Whether the words are numeral terms is only checked on conversion.
+     */
+    bool is_german_numeral(const std::string_view &input)
+    {
+        bool letters = false;
+
+        for (const auto c : input)
+        {
+            if (symbol(c) >= 0)
+                letters = true;
+            else if (c != ' ' && c != '\t')
+                return false;
+        }
+
+        return letters && input != "minus" && input != "Minus";
+    }
+
+    /*
+     * Converts a German numeral to a number, e.g. "zwei Millionen dreihundertfünfundzwanzigtausend Komma fünf" to
+     * "2,325,000.5". Scale words of one million and above are separate words preceded by their count, which are of
+     * the long scale, regardless of the naming system of the conversion options.
+     * \throws std::invalid_argument exception if the numeral is empty or invalid.
+     */
+    std::string parse_german_numeral(const std::string_view &numeral, const conversion_options_t &conversion_options)
+    {
+        const auto &lexicon = get_german_lexicon();
+
+        std::array<uint16_t, max_groups_count> groups = {};
+        std::vector<const morpheme_t *> morphemes;
+        uint32_t count = 0;
+        bool counted = false;
+        std::string fractional;
+        auto last_place = static_cast<uint32_t>(max_integral_places);
+        bool negative = false;
+        bool integral = false;
+        bool comma = false;
+        std::size_t words_count = 0;
+
+        // The compound that is not followed by a scale word is the last one of the integral part.
+        const auto end_integral = [&]() {
+            if (!counted)
+                return;
+
+            groups[0] = static_cast<uint16_t>(count % 1000);
+            groups[1] = static_cast<uint16_t>(count / 1000);
+            last_place = 0;
+            counted = false;
+        };
+
+        for (std::size_t begin = 0; begin < numeral.size();)
+        {
+            if (numeral[begin] == ' ' || numeral[begin] == '\t')
+            {
+                begin++;
+                continue;
+            }
+
+            auto end = begin;
+            for (; end < numeral.size() && numeral[end] != ' ' && numeral[end] != '\t'; end++);
+
+            const auto word = numeral.substr(begin, end - begin);
+            begin = end;
+            words_count++;
+
+            if (!lexicon.segment(word, morphemes))
+            {
+                const auto message = boost::format("\"%1%\" is not a German numeral term") % word;
+                throw std::invalid_argument(message.str());
+            }
+
+            const auto kind = morphemes.size() == 1 ? morphemes.front()->kind : morpheme_kind_t::none;
+
+            if (comma)
+            {
+                if (kind != morpheme_kind_t::zero && kind != morpheme_kind_t::one_final && kind != morpheme_kind_t::unit)
+                {
+                    const auto message = boost::format("\"%1%\" is not a digit of the fractional part") % word;
+                    throw std::invalid_argument(message.str());
+                }
+
+                fractional += static_cast<char>('0' + morphemes.front()->value);
+            }
+            else if (kind == morpheme_kind_t::minus)
+            {
+                if (words_count > 1)
+                    throw std::invalid_argument("\"minus\" is only allowed at the beginning of a numeral");
+
+                negative = true;
+            }
+            else if (kind == morpheme_kind_t::comma)
+            {
+                end_integral();
+                comma = true;
+            }
+            else if (kind == morpheme_kind_t::scale)
+            {
+                const auto place = morphemes.front()->value;
+
+                if (!counted || count == 0 || count >= 1000)
+                {
+                    const auto message = boost::format("\"%1%\" has to be preceded by a count from one to nine hundred "
+                                                       "ninety-nine") % word;
+                    throw std::invalid_argument(message.str());
+                }
+
+                if (place >= last_place)
+                {
+                    const auto message = boost::format("\"%1%\" has to be of lower magnitude than the scale word "
+                                                       "before") % word;
+                    throw std::invalid_argument(message.str());
+                }
+
+                groups[place / 3] = static_cast<uint16_t>(count);
+                last_place = place;
+                counted = false;
+            }
+            else
+            {
+                uint32_t value;
+                if (counted || last_place == 0 || !parse_compound(morphemes, value) ||
+                    (value == 0 && last_place != max_integral_places))
+                {
+                    const auto message = boost::format("\"%1%\" is not valid at this position of a numeral") % word;
+                    throw std::invalid_argument(message.str());
+                }
+
+                count = value;
+                counted = true;
+                integral = true;
+            }
+        }
+
+        end_integral();
+
+        if (!integral && !comma)
+            throw std::invalid_argument("the numeral must not be empty");
+
+        // As in English numerals, "Komma" needs to be followed by the fractional part.
+        if (comma && fractional.empty())
+            throw std::invalid_argument("\"Komma\" is not a valid term");
+
+        std::string number;
+        auto top = groups.size();
+        for (; top > 0 && groups[top - 1] == 0; top--);
+
+        if (top == 0)
+        {
+            number = "0";
+        }
+        else
+        {
+            number = std::to_string(groups[top - 1]);
+            for (auto group = top - 1; group-- > 0;)
+            {
+                const auto digits = std::to_string(groups[group]);
+                number.append(3 - digits.size(), '0');
+                number += digits;
+            }
+
+            if (conversion_options.use_thousands_separators)
+                add_thousands_separators(number, conversion_options.thousands_separator_symbol);
+        }
+
+        if (negative)
+            number.insert(0, 1, '-');
+
+        if (comma)
+        {
+            number += conversion_options.decimal_separator_symbol;
+            number += fractional;
+        }
+
+        return number;
+    }
+
+    /*
+     * Describes the German lexicon by the text, kind and value of each of its morphemes, one per line, e.g. "zwanzig 8
+     * 20", so that results converted with another lexicon can be told apart.
+     */
+    std::string describe_german_lexicon()
+    {
+        std::string description;
+        for (const auto &morpheme : get_german_lexicon().morphemes())
+        {
+            description += morpheme.text;
+            description += ' ';
+            description += std::to_string(static_cast<uint32_t>(morpheme.kind));
+            description += ' ';
+            description += std::to_string(morpheme.value);
+            description += '\n';
+        }
+
+        return description;
+    }
+
+    /*
+     * Renders the German numeral of a number given by its parts, e.g. "zwei Millionen dreihunderttausend Komma fünf".
+     * Numbers below one million are written as single compound words; scale words are capitalized nouns with their
+     * plural forms, and a one before them is "eine", e.g. "eine Milliarde".
+     * \throws std::logic_error exception if the number is too large or a digit is invalid.
+     */
+    std::string render_german_numeral(const bool negative, const std::string_view &integral,
+                                      const std::string_view &fractional,
+                                      const conversion_options_t &conversion_options)
+    {
+        const auto leading_zeros = integral.empty() ? 0 : std::min(integral.find_first_not_of('0'), integral.size() - 1);
+        const auto digits = integral.substr(leading_zeros);
+
+        if (digits.size() > max_integral_places)
+            throw std::logic_error("scale words greater than \"Dezilliarde\" are not supported");
+
+        std::string numeral;
+        numeral.reserve(16 * (digits.size() + fractional.size()));
+
+        const auto separate = [&]() {
+            if (!numeral.empty())
+                numeral += ' ';
+        };
+
+        if (negative)
+            numeral += "minus";
+
+        // A zero integral part is left out if it is the leading term and no leading zero is forced.
+        if (digits == "0" && (negative || conversion_options.force_leading_zero))
+        {
+            separate();
+            numeral += unit_texts[0];
+        }
+        else if (!digits.empty() && digits != "0")
+        {
+            for (auto group = (digits.size() + 2) / 3; group-- > 2;)
+            {
+                const auto value = group_value(digits, group);
+                if (value == 0)
+                    continue;
+
+                const auto place = 3 * group;
+                const auto illiarde = place % 6 == 3;
+
+                separate();
+                if (value == 1)
+                    numeral += "eine";
+                else
+                    append_group(value, "eine", numeral);
+
+                numeral += ' ';
+                numeral += scale_prefixes[place / 6 - 1];
+                numeral += illiarde ? "illiarde" : "illion";
+                if (value > 1)
+                    numeral += illiarde ? "n" : "en";
+            }
+
+            const auto value = group_value(digits, 1) * 1000 + group_value(digits, 0);
+            if (value > 0)
+            {
+                separate();
+                append_compound(value, numeral);
+            }
+        }
+
+        if (!fractional.empty())
+        {
+            separate();
+            numeral += "Komma";
+
+            for (const auto digit : fractional)
+            {
+                if (digit < '0' || digit > '9')
+                {
+                    const auto message = boost::format("unable to resolve term for value \"%1%\"") % digit;
+                    throw std::logic_error(message.str());
+                }
+
+                numeral += ' ';
+                numeral += unit_texts[digit - '0'];
+            }
+        }
+
+        return numeral;
+    }
+}
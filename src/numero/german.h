@@ -0,0 +1,31 @@
+#ifndef NUMERO_GERMAN_H
+#define NUMERO_GERMAN_H
+
+#include <string>
+#include <string_view>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    /*
+     * Checks whether the conversion options select German numerals, i.e. a language code such as "de", "de-de",
+     * "de-at" or "de-ch".
+     */
+    inline bool is_german(const conversion_options_t &conversion_options)
+    {
+        const auto language = conversion_options.language;
+        return language.size() >= 2 && (language[0] == 'd' || language[0] == 'D') &&
+               (language[1] == 'e' || language[1] == 'E') && (language.size() == 2 || language[2] == '-' ||
+                                                              language[2] == '_');
+    }
+
+    bool is_german_numeral(const std::string_view &input);
+    std::string parse_german_numeral(const std::string_view &numeral, const conversion_options_t &conversion_options);
+    std::string describe_german_lexicon();
+    std::string render_german_numeral(bool negative, const std::string_view &integral,
+                                      const std::string_view &fractional,
+                                      const conversion_options_t &conversion_options);
+};
+
+#endif //NUMERO_GERMAN_H
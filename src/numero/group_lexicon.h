@@ -0,0 +1,57 @@
+#ifndef NUMERO_GROUP_LEXICON_H
+#define NUMERO_GROUP_LEXICON_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    /*
+     * Numerals of all group values, i.e. from 0 to 999 or to 9,999 in the myriad system, and the radices and scale words
+     * of all groups of 64-bit integers in the naming system. They are rendered once by parse_integral_numeral, so that
+     * numerals composed of them are exactly what to_numeral renders.
+     */
+    struct group_lexicon_t
+    {
+        // 64-bit integers have up to ten groups in the Indian system, whose groups above the thousands have two places.
+        static constexpr std::size_t max_groups_count = 10;
+
+        explicit group_lexicon_t(naming_system_t naming_system);
+
+        std::string phrases;
+        std::vector<uint32_t> phrase_offsets;
+        std::vector<uint8_t> phrase_sizes;
+        std::array<uint32_t, max_groups_count> radices;
+        std::array<std::string, max_groups_count> scale_words;
+
+        // The phrases are followed by padding and the scale words are also stored in slots of a fixed size, so that
+        // both can be copied in chunks of that size, which is greater than any phrase and any scale word.
+        static constexpr std::size_t chunk_size = 48;
+        std::array<std::array<char, chunk_size>, max_groups_count> scale_word_chunks = {};
+    };
+
+    const group_lexicon_t &get_group_lexicon(naming_system_t naming_system);
+
+    /*
+     * Splits the value into the groups of the naming system of the lexicon, the least significant group first.
+     * \returns the number of groups up to the most significant non-zero group.
+     */
+    inline std::size_t split_groups(uint64_t value, const group_lexicon_t &lexicon,
+                                    uint32_t (&groups)[group_lexicon_t::max_groups_count])
+    {
+        std::size_t groups_count = 0;
+        for (; value > 0; groups_count++)
+        {
+            const auto radix = lexicon.radices[groups_count];
+            groups[groups_count] = static_cast<uint32_t>(value % radix);
+            value /= radix;
+        }
+        return groups_count;
+    }
+};
+
+#endif //NUMERO_GROUP_LEXICON_H
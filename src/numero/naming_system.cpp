@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "naming_system.h"
+
+namespace num
+{
+    namespace
+    {
+        /*
+         * Description of a naming system: the sizes of its digit groups from the least significant one on, of which
+         * the last size repeats, and the scale words of all groups but the first one in ascending order.
+         */
+        struct naming_system_description_t
+        {
+            std::string_view name;
+            std::vector<uint8_t> group_sizes;
+            std::vector<term_id_t> scale_words;
+            naming_system_table_t::latin_shift_t illion_shift;
+            naming_system_table_t::latin_shift_t illiard_shift;
+        };
+
+        /*
+         * The scale words of the short scale ("thousand", "million", "billion", ...) or of the long scale ("thousand",
+         * "million", "milliard", "billion", "billiard", ...) up to "centillion" or "centilliard" respectively.
+         */
+        std::vector<term_id_t> latin_scale_words(const bool illiards)
+        {
+            std::vector<term_id_t> scale_words = { term_thousand };
+
+            for (int factor = 1; factor <= 100; factor++)
+            {
+                scale_words.push_back(illion_term(factor));
+                if (illiards)
+                    scale_words.push_back(illiard_term(factor));
+            }
+
+            return scale_words;
+        }
+
+        naming_system_table_t compile(const naming_system_description_t &description)
+        {
+            naming_system_table_t table;
+            table.name = description.name;
+            table.illion_shift = description.illion_shift;
+            table.illiard_shift = description.illiard_shift;
+
+            // "hundred", "thousand" and "myriad" multiply in all naming systems, even where they name no group.
+            table.shifts[term_hundred] = 2;
+            table.shifts[term_thousand] = 3;
+            table.shifts[term_myriad] = 4;
+
+            uint32_t place = 0;
+            for (std::size_t group = 0; group <= description.scale_words.size(); group++)
+            {
+                const auto size = description.group_sizes[std::min(group, description.group_sizes.size() - 1)];
+                table.group_places.push_back(place);
+
+                if (group > 0)
+                {
+                    const auto term = description.scale_words[group - 1];
+                    table.shifts[term] = static_cast<uint16_t>(place);
+                    table.scale_places[term] = static_cast<uint16_t>(place);
+                    table.scale_group_sizes[term] = size;
+                }
+
+                table.group_terms.push_back(group > 0 ? description.scale_words[group - 1] : term_id_t());
+                place += size;
+            }
+
+            table.group_places.push_back(place);
+            return table;
+        }
+
+        /*
+         * The compiled naming systems indexed by naming_system_t; the undefined naming system is the short scale.
+         */
+        const auto naming_system_tables = []() {
+            const naming_system_description_t short_scale = { "short scale", { 3 }, latin_scale_words(false),
+                                                               { 3, 3 }, { 0, 0 } };
+            const naming_system_description_t long_scale = { "long scale", { 3 }, latin_scale_words(true), { 6, 0 },
+                                                              { 6, 3 } };
+            const naming_system_description_t indian = { "Indian", { 3, 2 }, {
+                term_thousand, term_lakh, term_crore, term_arab, term_kharab, term_neel, term_padma, term_shankh,
+                term_jaladhi, term_antya, term_madhya, term_parardha
+            }, { 0, 0 }, { 0, 0 } };
+            const naming_system_description_t myriad = { "myriad", { 4 }, {
+                term_myriad, term_oku, term_cho, term_kei, term_gai
+            }, { 0, 0 }, { 0, 0 } };
+
+            return std::array<naming_system_table_t, 5> {
+                compile(short_scale), compile(short_scale), compile(long_scale), compile(indian), compile(myriad)
+            };
+        }();
+    }
+
+    /*
+     * Gets the compiled tables of the given naming system.
+     * \throws std::invalid_argument exception if the naming system is not valid.
+     */
+    const naming_system_table_t &get_naming_system_table(const naming_system_t naming_system)
+    {
+        const auto index = static_cast<std::size_t>(naming_system);
+        if (index >= naming_system_tables.size())
+            throw std::invalid_argument("the naming system is not valid");
+
+        return naming_system_tables[index];
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef NUMERO_NAMING_SYSTEM_H
+#define NUMERO_NAMING_SYSTEM_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "numero/numero.h"
+
+namespace num
+{
+    /*
+     * Naming system compiled from its description into lookup tables, so that neither parsing nor rendering branches on
+     * the naming system. Numerals are rendered in digit groups, the least significant one first, each of which is
+     * followed by the scale word that names its place, e.g. "lakh" for the group of places 5 and 6 in the Indian system.
+     */
+    struct naming_system_table_t
+    {
+        /*
+         * Multiplicative shift of scale words composed of a Latin prefix and root by their factor, e.g. "trillion" and
+         * "unbillion" of factor 3 in the short scale, as factor * shift + offset; a zero shift where they do not apply.
+         */
+        struct latin_shift_t
+        {
+            uint16_t shift = 0;
+            uint16_t offset = 0;
+        };
+
+        std::string_view name;
+
+        // The multiplicative shift of every term, e.g. 2 for "hundred"; zero for terms that are not multiplicative in
+        // the naming system, e.g. "milliard" in the short scale.
+        std::array<uint16_t, terms_count> shifts = {};
+
+        // The place and the size of the group that every scale word names; zero for all other terms.
+        std::array<uint16_t, terms_count> scale_places = {};
+        std::array<uint8_t, terms_count> scale_group_sizes = {};
+
+        // The first place of every group plus the place behind the last group, and the scale word of every group but
+        // the first one.
+        std::vector<uint32_t> group_places;
+        std::vector<term_id_t> group_terms;
+
+        // The shifts of "-illion" and "-illiard" words, which also apply to those that are not spelled the common way.
+        latin_shift_t illion_shift;
+        latin_shift_t illiard_shift;
+
+        inline std::size_t groups_count() const {
+            return group_terms.size();
+        }
+
+        inline uint32_t group_size(const std::size_t group) const {
+            return group_places[group + 1] - group_places[group];
+        }
+
+        inline uint32_t max_places() const {
+            return group_places.back();
+        }
+    };
+
+    const naming_system_table_t &get_naming_system_table(naming_system_t naming_system);
+};
+
+#endif //NUMERO_NAMING_SYSTEM_H
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "numero/numeral_parser.h"
+#include "parser.h"
+
+namespace num
+{
+    class numeral_parser_c::impl_c
+    {
+    public:
+        explicit impl_c(const conversion_options_t &conversion_options) :
+            _conversion_options(conversion_options),
+            _parser(_conversion_options, term_text_t { &_terms })
+        {
+        }
+
+        inline const conversion_options_t &conversion_options() const {
+            return _conversion_options;
+        }
+
+        inline numeral_parser_state_t state() const {
+            return _state;
+        }
+
+        template <typename Term>
+        numeral_parser_state_t push(const Term &term)
+        {
+            if (_state == numeral_parser_state_t::invalid)
+                return _state;
+
+            try
+            {
+                auto current_text = text(term);
+
+                if (_fractional)
+                {
+                    if (is_point(term))
+                        throw std::logic_error("\"point\" is only allowed once in a numeral as a decimal separator");
+
+                    append_fractional_term(term, _fractional_digits);
+                    _state = numeral_parser_state_t::complete;
+                }
+                else if (is_point(term))
+                {
+                    // The integral part ends here, so it has to be valid on its own, unless it is left out.
+                    _integral_digits = integral_digits();
+                    _parser.finish();
+                    _fractional = true;
+                    _state = numeral_parser_state_t::incomplete;
+                }
+                else
+                {
+                    _terms.push_back(std::move(current_text));
+                    push_integral_term(_parser, term, _conversion_options);
+                    update_integral_digits();
+                }
+            }
+            catch (const std::exception &)
+            {
+                _state = numeral_parser_state_t::invalid;
+                _exception = std::current_exception();
+            }
+
+            return _state;
+        }
+
+        std::string value() const
+        {
+            if (_state == numeral_parser_state_t::invalid)
+                return {};
+
+            std::string value = integral_digits();
+
+            if (!value.empty() && _conversion_options.use_thousands_separators)
+                add_thousands_separators(value, _conversion_options.thousands_separator_symbol);
+
+            if (_parser.negative() && !value.empty())
+                value.insert(0, 1, '-');
+
+            if (!_fractional_digits.empty())
+            {
+                if (value.empty())
+                    value = "0";
+
+                value.append(1, _conversion_options.decimal_separator_symbol).append(_fractional_digits);
+            }
+
+            return value;
+        }
+
+        std::string finish() const
+        {
+            if (_state == numeral_parser_state_t::invalid)
+                std::rethrow_exception(_exception);
+
+            if (_terms.empty() && !_fractional)
+                throw std::invalid_argument("the numeral must not be empty");
+
+            if (_state == numeral_parser_state_t::incomplete)
+            {
+                if (_fractional)
+                    throw std::invalid_argument("\"point\" is not a valid term");
+                throw std::invalid_argument("the numeral is invalid");
+            }
+
+            return value();
+        }
+
+        std::string error() const
+        {
+            try
+            {
+                if (_exception)
+                    std::rethrow_exception(_exception);
+            }
+            catch (const std::exception &ex)
+            {
+                return ex.what();
+            }
+
+            return {};
+        }
+
+    private:
+        struct term_text_t
+        {
+            const std::vector<std::string> *terms;
+
+            inline std::string_view operator()(const std::size_t position) const {
+                return (*terms)[position];
+            }
+        };
+
+        static bool is_point(const std::string_view &term) {
+            return term == "point";
+        }
+
+        static bool is_point(const term_id_t term) {
+            return term == term_point;
+        }
+
+        /*
+         * Terms given as text have to consist of either lower case letters or digits only, just as the terms of
+         * numerals converted at once.
+         * \throws std::invalid_argument exception if they do not.
+         */
+        static std::string text(const std::string_view &term)
+        {
+            const auto is_lower = [](const char c) { return c >= 'a' && c <= 'z'; };
+            const auto is_digit = [](const char c) { return c >= '0' && c <= '9'; };
+
+            if (!std::all_of(term.begin(), term.end(), is_lower) && !std::all_of(term.begin(), term.end(), is_digit))
+                throw std::invalid_argument("the numeral is invalid");
+
+            return std::string(term);
+        }
+
+        static std::string text(const term_id_t term) {
+            return std::string(term_text(term));
+        }
+
+        /*
+         * Merges the groups completed by the last term once and checks that the current group does not overlap them,
+         * without merging it yet, so that the cost of a term depends on the current group only and not on the groups
+         * before it. Overlapping groups can not be repaired by any further terms.
+         */
+        void update_integral_digits()
+        {
+            for (; _merged_groups_count < _parser.groups().size(); _merged_groups_count++)
+                merge_places(_parser.groups()[_merged_groups_count], _merged_groups_digits);
+
+            if (_parser.at_beginning())
+            {
+                _state = numeral_parser_state_t::incomplete;
+                return;
+            }
+
+            _parser.check();
+
+            const auto &current_group = _parser.current_group();
+            const auto places = std::min(current_group.size(), _merged_groups_digits.size());
+
+            for (std::size_t place = 1; place <= places; place++)
+            {
+                if (current_group[current_group.size() - place] != '0' &&
+                    _merged_groups_digits[_merged_groups_digits.size() - place] != '0')
+                    throw std::logic_error("sub numerals overlap the same place and cannot be merged");
+            }
+
+            _state = numeral_parser_state_t::complete;
+        }
+
+        /*
+         * Merges the current group on top of the groups before it, only when the value is requested. Once the integral
+         * part has ended with "point", its digits are kept as they were.
+         */
+        std::string integral_digits() const
+        {
+            if (_fractional)
+                return _integral_digits;
+
+            if (_parser.at_beginning())
+                return {};
+
+            std::string digits = _merged_groups_digits;
+            merge_places(_parser.current_group(), digits);
+            return digits;
+        }
+
+    private:
+        const conversion_options_t _conversion_options;
+        std::vector<std::string> _terms;
+        integral_number_parser_c<term_text_t> _parser;
+
+        numeral_parser_state_t _state = numeral_parser_state_t::incomplete;
+        std::exception_ptr _exception;
+        bool _fractional = false;
+        std::size_t _merged_groups_count = 0;
+        std::string _merged_groups_digits;
+        std::string _integral_digits;
+        std::string _fractional_digits;
+    };
+
+    numeral_parser_c::numeral_parser_c() :
+        numeral_parser_c(conversion_options_t())
+    {
+    }
+
+    numeral_parser_c::numeral_parser_c(const conversion_options_t &conversion_options) :
+        _impl(std::make_unique<impl_c>(conversion_options))
+    {
+    }
+
+    numeral_parser_c::~numeral_parser_c() = default;
+
+    /*
+     * Pushes the next term of the numeral. Terms given as text may be hyphenated, e.g. "twenty-one". Once the terms are
+     * invalid, further terms are ignored.
+     *
+     * \param term The next term.
+     * \returns the state of the numeral after the term.
+     */
+    numeral_parser_state_t numeral_parser_c::push(const std::string_view &term)
+    {
+        for (std::size_t begin = 0, end; begin < term.size(); begin = end + 1)
+        {
+            end = term.find_first_of("- \t", begin);
+            if (end == std::string_view::npos)
+                end = term.size();
+
+            if (end > begin)
+                _impl->push(term.substr(begin, end - begin));
+        }
+
+        return _impl->state();
+    }
+
+    numeral_parser_state_t numeral_parser_c::push(const term_id_t term)
+    {
+        return _impl->push(term);
+    }
+
+    /*
+     * Finishes the numeral. Further terms may still be pushed afterwards.
+     *
+     * \returns the number of the numeral, the same as converting the terms pushed so far.
+     * \throws std::invalid_argument exception if the numeral is invalid or incomplete.
+     */
+    std::string numeral_parser_c::finish()
+    {
+        return _impl->finish();
+    }
+
+    /*
+     * Forgets all terms pushed so far, so that the next numeral can be parsed.
+     */
+    void numeral_parser_c::reset()
+    {
+        _impl = std::make_unique<impl_c>(_impl->conversion_options());
+    }
+
+    numeral_parser_state_t numeral_parser_c::state() const
+    {
+        return _impl->state();
+    }
+
+    /*
+     * Gets the value of the terms pushed so far, e.g. "2,000" after "two thousand", or an empty string if there is
+     * none yet or the terms are invalid. It is also available while the numeral is incomplete, e.g. "3" after "three
+     * point". The value is only assembled when requested, so it costs as much as the number of its places.
+     */
+    std::string numeral_parser_c::partial_value() const
+    {
+        return _impl->value();
+    }
+
+    /*
+     * Gets the reason why the terms pushed so far are invalid, or an empty string if they are not.
+     */
+    std::string numeral_parser_c::error() const
+    {
+        return _impl->error();
+    }
+}
@@ -0,0 +1,155 @@
+#include <stdexcept>
+
+#include "numero/numeral_range.h"
+#include "german.h"
+#include "group_lexicon.h"
+
+namespace num
+{
+    static_assert(numeral_range_c::iterator::max_groups_count == group_lexicon_t::max_groups_count);
+
+    numeral_range_c::iterator::iterator(const group_lexicon_t *lexicon, const uint64_t value, const uint64_t last,
+                                        const bool force_leading_zero) :
+        _lexicon(lexicon),
+        _value(value),
+        _last(last),
+        _past_end(false)
+    {
+        _groups_count = split_groups(value, *_lexicon, _groups);
+
+        if (_groups_count > 0)
+            render(_groups_count - 1);
+        else if (force_leading_zero)
+            _numeral.assign(_lexicon->phrases, _lexicon->phrase_offsets[0], _lexicon->phrase_sizes[0]);
+    }
+
+    /*
+     * Steps to the next integer. Only the group that was incremented and those that overflowed below it are rendered
+     * again; everything in front of them is kept.
+     */
+    numeral_range_c::iterator &numeral_range_c::iterator::operator++()
+    {
+        if (_value == _last)
+        {
+            _past_end = true;
+            return *this;
+        }
+
+        _value++;
+
+        std::size_t group = 0;
+        for (; ++_groups[group] == _lexicon->radices[group]; group++)
+            _groups[group] = 0;
+
+        if (group >= _groups_count)
+        {
+            _groups_count = group + 1;
+            _group_offsets[group] = 0;
+        }
+
+        render(group);
+        return *this;
+    }
+
+    /*
+     * Renders the groups from the given one down to the least significant one, replacing whatever they were rendered to
+     * before.
+     */
+    void numeral_range_c::iterator::render(const std::size_t top_group)
+    {
+        _numeral.resize(_group_offsets[top_group]);
+
+        for (auto group = top_group + 1; group-- > 0;)
+        {
+            _group_offsets[group] = _numeral.size();
+
+            const auto value = _groups[group];
+            if (value == 0)
+                continue;
+
+            if (!_numeral.empty())
+                _numeral += ' ';
+
+            _numeral.append(_lexicon->phrases, _lexicon->phrase_offsets[value], _lexicon->phrase_sizes[value]);
+            _numeral += _lexicon->scale_words[group];
+        }
+    }
+
+    numeral_range_c::numeral_range_c(const uint64_t first, const uint64_t last) :
+        numeral_range_c(first, last, conversion_options_t())
+    {
+    }
+
+    /*
+     * Creates the range of the numerals of the integers from first to last, both included.
+     * \param first The first integer of the range.
+     * \param last The last integer of the range.
+     * \param conversion_options The conversion options; only the naming system and whether zero is rendered apply.
+     * \throws std::invalid_argument exception if last is less than first or the conversion options select German
+     * numerals, which are not composed of the groups that the range renders.
+     */
+    numeral_range_c::numeral_range_c(const uint64_t first, const uint64_t last,
+                                     const conversion_options_t &conversion_options) :
+        numeral_range_c(first, last, &get_group_lexicon(conversion_options.naming_system),
+                        conversion_options.force_leading_zero)
+    {
+        if (is_german(conversion_options))
+            throw std::invalid_argument("numeral ranges do not support German numerals");
+    }
+
+    numeral_range_c::numeral_range_c(const uint64_t first, const uint64_t last, const group_lexicon_t *lexicon,
+                                     const bool force_leading_zero) :
+        _first(first),
+        _last(last),
+        _lexicon(lexicon),
+        _force_leading_zero(force_leading_zero)
+    {
+        if (last < first)
+            throw std::invalid_argument("the last integer of a range must not be less than the first one");
+    }
+
+    numeral_range_c::iterator numeral_range_c::begin() const
+    {
+        return iterator(_lexicon, _first, _last, _force_leading_zero);
+    }
+
+    numeral_range_c::iterator numeral_range_c::end() const
+    {
+        auto it = iterator();
+        it._value = _last;
+        return it;
+    }
+
+    /*
+     * Splits the range into consecutive subranges of nearly the same size, e.g. to render them in parallel. Each
+     * subrange only renders its first numeral from scratch.
+     * \param count The number of subranges.
+     * \returns at most count subranges that together cover the range, fewer if the range has less integers.
+     * \throws std::invalid_argument exception if count is zero.
+     */
+    std::vector<numeral_range_c> numeral_range_c::partition(const std::size_t count) const
+    {
+        if (count == 0)
+            throw std::invalid_argument("a range can not be partitioned into zero subranges");
+
+        // The range has steps + 1 integers, of which the first remainder + 1 subranges get one more.
+        const uint64_t steps = _last - _first;
+        const uint64_t quotient = steps / count;
+        const uint64_t remainder = steps % count;
+
+        std::vector<numeral_range_c> subranges;
+        uint64_t first = _first;
+
+        for (std::size_t subrange = 0; subrange < count; subrange++)
+        {
+            const uint64_t size = quotient + (subrange <= remainder ? 1 : 0);
+            if (size == 0)
+                break;
+
+            subranges.push_back(numeral_range_c(first, first + (size - 1), _lexicon, _force_leading_zero));
+            first += size;
+        }
+
+        return subranges;
+    }
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -8,13 +11,20 @@
 #include <sstream>
 #include <regex>
 #include <limits>
+#include <optional>
 
 #include <boost/bimap.hpp>
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
+#include "numero/digit_grouping.h"
 #include "numero/numero.h"
+#include "numero/result_cache.h"
+#include "german.h"
+#include "naming_system.h"
+#include "parser.h"
+#include "shadow.h"
 
 namespace num
 {
@@ -130,32 +140,131 @@ namespace num
     });
 
     /*
-     * The following defines some constant multiplicative shifts that, other than -illion and -illiard don't follow a
-     * special deduction rule.
+     * The greatest absolute exponent of numbers in scientific notation that is resolved. It is well above the places of
+     * the greatest convertible number, but keeps inputs such as "1e999999999" from being blown up to gigabytes.
      */
-    const auto multiplicative_shifts = make_bimap<int, std::string_view>({
-        { 2, "hundred" },
-        { 3, "thousand" },
-        { 4, "myriad" }
-    });
-    
+    const int32_t max_exponent = 4096;
+
     /*
-     * Finds the prefix that the subject starts with.
-     * \param subject the subject to find the prefix for.
-     * \returns the iterator of a prefix-value pair in value_to_prefix.right if found; value_to_prefix.right.end() if
-     * no prefix could be found.
+     * Checks an exponent that was extracted from a number without resolving it, as the exponents of numbers that are
+     * converted are checked.
+     * \param number The number that the exponent was extracted from.
+     * \param exponent The extracted exponent.
+     * \throws std::out_of_range exception if the exponent is out of the supported range.
      */
-    auto find_prefix(const std::string_view &subject)
+    void check_exponent_range(const std::string_view &number, const int32_t exponent)
     {
-        auto it = value_to_prefix.right.begin();
-        for (; it != value_to_prefix.right.end(); it++)
+        if (exponent >= -max_exponent && exponent <= max_exponent)
+            return;
+
+        const auto message = boost::format("the exponent %1% is out of the supported range of -%2% to %2%")
+                             % number.substr(number.find_last_of("eE") + 1) % max_exponent;
+        throw std::out_of_range(message.str());
+    }
+
+    /*
+     * Finds the Latin root of the given factor including its prefix, e.g. "trevigint" for 23.
+     * \param factor the factor from 1 to 100.
+     * \returns the Latin root without suffix.
+     * \throws std::logic_error exception if the factor does not resolve to a Latin root.
+     */
+    std::string find_latin_root(const int factor)
+    {
+        const auto &factor_root_pair_it = factor_to_root.left.find(factor);
+        if (factor_root_pair_it != factor_to_root.left.end())
+            return std::string(factor_root_pair_it->second);
+
+        const auto prefix_value = factor % 10;
+        const auto &value_prefix_pair_it = value_to_prefix.left.find(prefix_value);
+        if (value_prefix_pair_it == value_to_prefix.left.end())
         {
-            if (subject.substr(0, it->first.size()) == it->first)
-                return it;
+            const auto message = boost::format("unable to resolve latin prefix for value %1%") % prefix_value;
+            throw std::logic_error(message.str());
         }
-        return value_to_prefix.right.end();
+
+        const auto base_factor = factor - prefix_value;
+        const auto &base_factor_root_pair_it = factor_to_root.left.find(base_factor);
+        if (base_factor_root_pair_it == factor_to_root.left.end())
+        {
+            const auto message = boost::format("unable to resolve latin root for base factor %1%") % base_factor;
+            throw std::logic_error(message.str());
+        }
+
+        return std::string(value_prefix_pair_it->second) + std::string(base_factor_root_pair_it->second);
     }
 
+    /*
+     * The texts of all terms indexed by their term identifier.
+     */
+    const auto term_texts = []() {
+        std::array<std::string, terms_count> texts;
+
+        for (int value = 0; value < 20; value++)
+            texts[unit_term(value)] = value_to_term.left.at(std::to_string(value));
+
+        for (int tens = 2; tens < 10; tens++)
+            texts[tens_term(tens)] = value_to_term.left.at(std::to_string(tens * 10));
+
+        texts[term_hundred] = "hundred";
+        texts[term_thousand] = "thousand";
+        texts[term_myriad] = "myriad";
+        texts[term_negative] = "negative";
+        texts[term_minus] = "minus";
+        texts[term_point] = "point";
+        texts[term_a] = "a";
+        texts[term_lakh] = "lakh";
+        texts[term_crore] = "crore";
+        texts[term_arab] = "arab";
+        texts[term_kharab] = "kharab";
+        texts[term_neel] = "neel";
+        texts[term_padma] = "padma";
+        texts[term_shankh] = "shankh";
+        texts[term_jaladhi] = "jaladhi";
+        texts[term_antya] = "antya";
+        texts[term_madhya] = "madhya";
+        texts[term_parardha] = "parardha";
+        texts[term_oku] = "oku";
+        texts[term_cho] = "cho";
+        texts[term_kei] = "kei";
+        texts[term_gai] = "gai";
+
+        for (int factor = 1; factor <= 100; factor++)
+        {
+            const auto root = find_latin_root(factor);
+            texts[illion_term(factor)] = root + "illion";
+            texts[illiard_term(factor)] = root + "illiard";
+        }
+
+        return texts;
+    }();
+
+    /*
+     * The additive values of all unit, teen and ten terms indexed by their term identifier.
+     */
+    const auto term_values = []() {
+        std::array<std::string_view, tens_term(9) + 1> values;
+
+        for (const auto &[value, term] : value_to_term.left)
+        {
+            const auto number = std::stoi(std::string(value));
+            values[number < 20 ? unit_term(number) : tens_term(number / 10)] = value;
+        }
+
+        return values;
+    }();
+
+    /*
+     * The term identifiers of all terms by their text.
+     */
+    const auto text_to_term_id = []() {
+        std::map<std::string_view, term_id_t> term_ids;
+
+        for (std::size_t term = 0; term < terms_count; term++)
+            term_ids.emplace(term_texts[term], static_cast<term_id_t>(term));
+
+        return term_ids;
+    }();
+
     /*
      * Finds the additive value for the given term.
      * \param term the term to find the additive value for.
@@ -208,94 +317,91 @@ namespace num
     }
 
     /*
-     * Finds the multiplicative shift of places dictated by the given term, e.g. the term "thousand" returns 3 as multi-
-     * plying by 1,000 shifts the multiplicand 3 places to the left.
-     * \param term the term to find the multiplicative shift for.
-     * \returns the multiplicative shift, a value greater than 0 if term is valid; 0 if the term is invalid.
-     * \throws std::invalid_argument exception if the term does not resolve to a multiplicative shift.
+     * Derives the multiplicative shift of a Latin scale word from the factor of its root, or of its prefix and root,
+     * e.g. 3 for "b" and 1 for "un" in "unbillion", which is "trillion" in the short scale. As by the reference
+     * engine, "-illiard" words are not valid terms in the short scale.
+     * \param term the scale word.
+     * \param root_base the scale word without its suffix "-illion" or "-illiard".
+     * \param latin_shift the shift of the suffix in the naming system.
+     * \returns the multiplicative shift, a value greater than 0.
+     * \throws std::invalid_argument exception if the naming system has no words of the suffix or the root is not valid.
      */
-    uint32_t find_multiplicative_shift(const std::string_view &term, const conversion_options_t &conversion_options)
+    uint32_t derive_latin_scale_shift(const std::string_view &term, const std::string_view &root_base,
+                                      const naming_system_table_t::latin_shift_t &latin_shift)
     {
-        static const std::regex latin_root_pattern("(.*)(illion|illiard)$");
-
-        std::string _term = std::string(term);
-        std::smatch matches;
-
-        if (std::regex_search(_term.cbegin(), _term.cend(), matches, latin_root_pattern))
+        if (latin_shift.shift == 0)
         {
-            const auto &root_base = matches[1].str();
-            const auto &root_suffix = matches[2].str();
-
-            if (conversion_options.naming_system != naming_system_t::long_scale && root_suffix == "illiard")
-                throw std::invalid_argument("using long scale terms but number naming system is not set to long scale");
-
-            auto short_scale_shift = [&](const int root_factor) {
-                return 3 * root_factor + 3;
-            };
+            const auto message = boost::format("\"%1%\" is not a valid term") % term;
+            throw std::invalid_argument(message.str());
+        }
 
-            auto long_scale_shift = [&](const int root_factor) {
-                return root_suffix == "illiard" ? 6 * root_factor + 3 : 6 * root_factor;
-            };
+        auto factor_it = factor_to_root.right.find(root_base);
+        int factor = 0;
 
-            std::function<int(const int)> scale_shift;
-            if (conversion_options.naming_system == naming_system_t::long_scale)
-                scale_shift = long_scale_shift;
-            else
-                scale_shift = short_scale_shift;
+        if (factor_it == factor_to_root.right.end())
+        {
+            auto prefix_it = value_to_prefix.right.begin();
+            for (; prefix_it != value_to_prefix.right.end() && !root_base.starts_with(prefix_it->first); prefix_it++);
 
-            const auto factor_it = factor_to_root.right.find(root_base);
-            if (factor_it != factor_to_root.right.end())
+            if (prefix_it == value_to_prefix.right.end())
             {
-                const auto root_factor = factor_it->second;
-                return scale_shift(root_factor);
+                const auto message = boost::format("\"%1%\" is not a valid root term") % root_base;
+                throw std::invalid_argument(message.str());
             }
-            else
+
+            const auto actual_root = root_base.substr(prefix_it->first.size());
+            factor_it = factor_to_root.right.find(actual_root);
+            if (factor_it == factor_to_root.right.end())
             {
-                const auto prefix_value_pair_it = find_prefix(root_base);
-                if (prefix_value_pair_it != value_to_prefix.right.end())
-                {
-                    const auto actual_prefix = prefix_value_pair_it->first;
-                    const auto actual_root = root_base.substr(actual_prefix.size());
-                    
-                    const auto factor_it = factor_to_root.right.find(actual_root);
-                    if (factor_it != factor_to_root.right.end())
-                    {
-                        const auto root_factor = factor_it->second + prefix_value_pair_it->second;
-                        return scale_shift(root_factor);
-                    }
-                    // R-007: Verify valid terms in numeral.
-                    else
-                    {
-                        const auto message = boost::format("\"%1%\" is not a valid root term") % actual_root;
-                        throw std::invalid_argument(message.str());
-                    }
-                }
-                // R-007: Verify valid terms in numeral.
-                else
-                {
-                    const auto message = boost::format("\"%1%\" is not a valid root term") % root_base;
-                    throw std::invalid_argument(message.str());
-                }
+                const auto message = boost::format("\"%1%\" is not a valid root term") % actual_root;
+                throw std::invalid_argument(message.str());
             }
+
+            factor = prefix_it->second;
         }
-        else
+
+        factor += factor_it->second;
+        return latin_shift.shift * factor + latin_shift.offset;
+    }
+
+    /*
+     * Finds the multiplicative shift of places dictated by the given term, e.g. the term "thousand" returns 3 as multi-
+     * plying by 1,000 shifts the multiplicand 3 places to the left. The shift is looked up in the compiled table of the
+     * naming system, e.g. 9 for "milliard" in the long scale and 7 for "crore" in the Indian system. Latin scale words
+     * that are not in the table, e.g. "unbillion", are derived from their prefix and root in the short and long scale.
+     * \param term the term to find the multiplicative shift for.
+     * \returns the multiplicative shift, a value greater than 0.
+     * \throws std::invalid_argument exception if the term does not resolve to a multiplicative shift.
+     */
+    uint32_t find_multiplicative_shift(const std::string_view &term, const conversion_options_t &conversion_options)
+    {
+        const auto term_id = find_term_id(term);
+        const auto &naming_system_table = get_naming_system_table(conversion_options.naming_system);
+
+        if (term_id && naming_system_table.shifts[*term_id] > 0)
+            return naming_system_table.shifts[*term_id];
+
+        const auto illiard = term.ends_with("illiard");
+        if ((illiard || term.ends_with("illion")) && naming_system_table.illion_shift.shift > 0)
         {
-            const auto multiplicative_shift_it = multiplicative_shifts.right.find(term);
-            if (multiplicative_shift_it != multiplicative_shifts.right.end())
-            {
-                return multiplicative_shift_it->second;
-            }
-            else
-            {
-                const auto message = boost::format("\"%1%\" is not a valid term") % term;
-                throw std::invalid_argument(message.str());
-            }
+            return derive_latin_scale_shift(term, term.substr(0, term.size() - (illiard ? 7 : 6)),
+                                            illiard ? naming_system_table.illiard_shift :
+                                                      naming_system_table.illion_shift);
+        }
+
+        // R-007: Verify valid terms in numeral.
+        if (term_id && *term_id > term_a)
+        {
+            const auto message = boost::format("\"%1%\" is not a term of the %2% naming system") % term
+                                               % naming_system_table.name;
+            throw std::invalid_argument(message.str());
         }
 
-        return 0;
+        const auto message = boost::format("\"%1%\" is not a valid term") % term;
+        throw std::invalid_argument(message.str());
     }
 
-    void merge_places(const std::string &source, std::string &target)
+    void merge_places(const std::string_view &source, std::string &target)
     {
         if (target.empty())
         {
@@ -326,19 +432,7 @@ namespace num
 
     void add_thousands_separators(std::string &target, const char thousands_separator_symbol)
     {
-        if (target.find(thousands_separator_symbol) != std::string::npos)
-            return;
-        
-        std::stringstream ss;
-        const auto offset = target.size() % 3;
-        
-        for (std::size_t i = 0; i < target.size(); i++)
-        {
-            if (i > 0 && i % 3 == offset) ss << thousands_separator_symbol;
-            ss << target[i];
-        }
-
-        target = ss.str();
+        group_digits_in_place(target, std::string_view(&thousands_separator_symbol, 1), digit_grouping_t::thousands);
     }
 
     void strip_thousands_separators(std::string &target, const char thousands_separator_symbol)
@@ -350,196 +444,41 @@ namespace num
     {
         static const std::regex split_pattern("[\\s-]+");
 
-        const auto throw_duplicate_sub_numeral_magnitudes = [](const std::string &first_sub_numeral,
-                                                               const std::string &second_sub_numeral)
-        {
-            const auto message = boost::format("there must not be multiple sub numerals with the same magnitude: "
-                                               "\"%1%\" and \"%2%\".") % first_sub_numeral % second_sub_numeral;
-            throw std::invalid_argument(message.str());
-        };
-
-        const auto throw_incorrect_sub_numeral_order = [](const std::string &lower_magnitude_sub_numeral,
-                                                          const std::string &higher_magnitude_sub_numeral)
-        {
-            const auto message = boost::format("a higher magnitude sub numeral is not allowed to follow a "
-                                               "lower magnitude sub numeral: \"%1%\" follows \"%2%\". "
-                                               "Did you mean \"%1% %2%\"?")
-                                               % higher_magnitude_sub_numeral % lower_magnitude_sub_numeral;
-            throw std::invalid_argument(message.str());
-        };
-
         if (integral.empty())
             return {};
 
-        bool negative = false;
         std::string _integral = std::string(integral);
 
         auto it = std::sregex_token_iterator(_integral.begin(), _integral.end(), split_pattern, -1);
-        
-        std::vector<std::string> groups;
-        std::set<uint32_t> used_shifts;
-
-        std::string current_group;
-        std::string last_term;
-        std::string last_sub_numeral;
-        std::string current_sub_numeral;
-        std::string last_additive_value;
-        
-        uint32_t last_multiplicative_shift = 0;
-        uint32_t last_group_total_multiplicative_shift = std::numeric_limits<uint32_t>::max();
-        uint32_t current_group_total_multiplicative_shift = 0;
-        bool last_term_multiplicative = false;
-
-        for (; it != std::sregex_token_iterator(); it++)
-        {
-            const auto match = *it;
-            const auto term = match.str();
-            
-            if (groups.empty() && current_group.empty())
-            {
-                current_sub_numeral = term;
-                
-                if (term == "a")
-                {
-                    current_group = "1";
-                    last_term = term;
-                    continue;
-                }
-                else if (term == "negative" || term == "minus")
-                {
-                    negative = true;
-                    last_term = term;
-                    continue;
-                }
-            }
-            
-            std::exception_ptr find_additive_value_exception = nullptr;
-            std::exception_ptr find_multiplicative_shift_exception = nullptr;
-
-            std::string current_additive_value;
-            uint32_t current_multiplicative_shift = 0;
-
-            try {
-                current_additive_value = find_additive_value(term, 3, groups.empty() && current_group.empty());
-            } catch (const std::exception &e) {
-                find_additive_value_exception = std::current_exception();
-            }
-
-            try {
-                current_multiplicative_shift = find_multiplicative_shift(term, conversion_options);
-            } catch (const std::exception &e) {
-                find_multiplicative_shift_exception = std::current_exception();
-            }
-
-            // If the term is neither additive nor multiplicative, rethrow first exception and tell the term is unknown.
-            if (find_additive_value_exception && find_multiplicative_shift_exception)
-                std::rethrow_exception(find_additive_value_exception);
-
-            // Process additive term.
-            if (!find_additive_value_exception)
-            {
-                if (last_term_multiplicative && last_multiplicative_shift >= 3)
-                {
-                    if (current_group_total_multiplicative_shift == last_group_total_multiplicative_shift)
-                        throw_duplicate_sub_numeral_magnitudes(last_sub_numeral, current_sub_numeral);
-                    else if (current_group_total_multiplicative_shift > last_group_total_multiplicative_shift)
-                        throw_incorrect_sub_numeral_order(last_sub_numeral, current_sub_numeral);
-                    
-                    groups.push_back(current_group);
-                    
-                    if (conversion_options.debug_output)
-                    {
-                        std::cout << "Group number: " << current_group << "\n";
-                        std::cout << "New group" << "\n";
-                    }
-                    
-                    current_group = "";
-                    last_sub_numeral = current_sub_numeral;
-                    current_sub_numeral = term;
-                    last_group_total_multiplicative_shift = current_group_total_multiplicative_shift;
-                    current_group_total_multiplicative_shift = 0;
-                    last_multiplicative_shift = 0;
-                }
-
-                if (conversion_options.debug_output)
-                {
-                    std::cout << "Term: " << term << "\n";
-                    std::cout << "  Additive value: " << current_additive_value << "\n";
-                }
-                
-                last_term_multiplicative = false;
-
-                if (!last_additive_value.empty() && last_additive_value.size() < current_additive_value.size())
-                {
-                    const auto message = boost::format("greater value terms have to precede lower value terms. "
-                                                       "Did you mean \"%1% %2%\"?") % term % last_term;
-                    throw std::invalid_argument(message.str());
-                }
-                
-                merge_places(current_additive_value, current_group);
-
-                last_additive_value = current_additive_value;
-            }
-            // Process multiplicative term.
-            else
-            {
-                if (current_multiplicative_shift < last_multiplicative_shift)
-                {
-                    const auto message = boost::format("a lower multiplicative term is not allowed to follow a "
-                                                       "higher multiplicative term: \"%1% %2%\". "
-                                                       "Did you mean \"%2% %1%\" or did you forget an additive term "
-                                                       "in front of \"%2%\"?") % last_term % term;
-                    throw std::invalid_argument(message.str());
-                }
-                
-                // Add an implicit 1 if that is missing at the beginning of the numeral.
-                if (groups.empty() && current_group.empty())
-                    current_group = "1";
-                
-                if (current_group == "0")
-                    throw std::invalid_argument("in the integral part \"zero\" is only allowed on its own.");
-                
-                if (conversion_options.debug_output)
-                {
-                    std::cout << "Term: " << term << "\n";
-                    std::cout << "  Multiplicative value: 10^" << current_multiplicative_shift << "\n";
-                }
-                
-                current_sub_numeral += " " + term;
-                last_term_multiplicative = true;
-                last_multiplicative_shift = current_multiplicative_shift;
-                current_group_total_multiplicative_shift += current_multiplicative_shift;
-
-                shift_places(current_multiplicative_shift, current_group);
 
-                last_additive_value.clear();
-            }
-            
-            last_term = term;
-        }
-
-        if (groups.empty() && current_group.empty() && negative)
-            throw std::invalid_argument("the numeral must not be empty");
+        std::vector<std::string> terms;
+        integral_number_parser_c parser(conversion_options, [&](const std::size_t position) {
+            return std::string_view(terms[position]);
+        });
 
-        if (current_group_total_multiplicative_shift == last_group_total_multiplicative_shift)
-            throw_duplicate_sub_numeral_magnitudes(last_sub_numeral, current_sub_numeral);
-        else if (current_group_total_multiplicative_shift > last_group_total_multiplicative_shift)
-            throw_incorrect_sub_numeral_order(last_sub_numeral, current_sub_numeral);
+        for (; it != std::sregex_token_iterator(); it++)
+            push_integral_term(parser, terms.emplace_back(it->str()), conversion_options);
 
-        groups.push_back(current_group);
+        return parser.finish();
+    }
 
-        std::string result;
+    /*
+     * Parses the integral part of a numeral given as term identifiers. Terms are classified by table lookups only;
+     * the rules are the same as for numerals given as text.
+     */
+    std::string parse_integral_number(std::span<const term_id_t> integral, const conversion_options_t &conversion_options)
+    {
+        if (integral.empty())
+            return {};
 
-        for (const auto &group : groups)
-            merge_places(group, result);
-        
-        if (conversion_options.use_thousands_separators)
-            add_thousands_separators(result, conversion_options.thousands_separator_symbol);
+        integral_number_parser_c parser(conversion_options, [&](const std::size_t position) {
+            return term_text(integral[position]);
+        });
 
-        if (negative)
-            result.insert(0, 1, '-');
+        for (const auto term : integral)
+            push_integral_term(parser, term, conversion_options);
 
-        return result;
+        return parser.finish();
     }
 
     std::string parse_fractional_number(const std::string_view &fractional,
@@ -565,12 +504,78 @@ namespace num
         return ss.str();
     }
 
+    std::string parse_fractional_number(std::span<const term_id_t> fractional)
+    {
+        std::string number;
+        number.reserve(fractional.size());
+
+        for (const auto term : fractional)
+            append_fractional_term(term, number);
+
+        return number;
+    }
+
     std::string converter_c::to_number(const std::string_view &numeral)
+    {
+        if (_conversion_options.max_term_edits > 0)
+        {
+            std::vector<term_correction_t> corrections;
+            return to_number(numeral, corrections);
+        }
+
+        std::string result;
+        const auto fingerprint = _result_cache ? result_cache_c::fingerprint(_conversion_options, "to_number") : 0;
+
+        if (_result_cache && _result_cache->find(fingerprint, numeral, result))
+            return result;
+
+        if (_shadow_engine && _shadow_engine->sample())
+            result = _shadow_engine->run("to_number", numeral, _conversion_options,
+                                         [&]() { return convert_to_number(numeral); });
+        else
+            result = convert_to_number(numeral);
+
+        if (_result_cache)
+            _result_cache->insert(fingerprint, numeral, result);
+
+        return result;
+    }
+
+    /*
+     * Converts a numeral to a number like to_number, but if the conversion options allow for edits, unknown terms are
+     * replaced by the closest terms of the lexicon first, e.g. "thre hundered" by "three hundred".
+     * \param numeral The numeral.
+     * \param corrections The vector that receives the corrections made.
+     * \returns the number.
+     * \throws std::invalid_argument exception if the numeral is empty or invalid even after the corrections.
+     */
+    std::string converter_c::to_number(const std::string_view &numeral, std::vector<term_correction_t> &corrections)
+    {
+        corrections.clear();
+        const auto corrected_numeral = correct_terms(numeral, corrections);
+
+        if (_shadow_engine && _shadow_engine->sample())
+            return _shadow_engine->run("to_number", corrected_numeral, _conversion_options,
+                                       [&]() { return convert_to_number(corrected_numeral); });
+
+        return convert_to_number(corrected_numeral);
+    }
+
+    std::string converter_c::convert_to_number(const std::string_view &numeral)
+    {
+        return convert_to_number(numeral, _conversion_options);
+    }
+
+    std::string converter_c::convert_to_number(const std::string_view &numeral,
+                                               const conversion_options_t &conversion_options)
     {
         static const std::regex split_pattern(" ?point ");
 
         if (numeral.empty())
             throw std::invalid_argument("the numeral must not be empty");
+
+        if (is_german(conversion_options))
+            return parse_german_numeral(numeral, conversion_options);
         
         if (!is_numeral(numeral))
             throw std::invalid_argument("the numeral is invalid");
@@ -590,16 +595,16 @@ namespace num
         if (parts.size() >= 3)
             throw std::logic_error("\"point\" is only allowed once in a numeral as a decimal separator");
 
-        auto number = parse_integral_number(parts[0], _conversion_options);
+        auto number = parse_integral_number(parts[0], conversion_options);
 
         if (parts.size() == 2)
         {
-            const auto parsed_fractional = parse_fractional_number(parts[1], _conversion_options);
+            const auto parsed_fractional = parse_fractional_number(parts[1], conversion_options);
 
             if (number.empty())
                 number = "0";
 
-            number.insert(number.end(), _conversion_options.decimal_separator_symbol);
+            number.insert(number.end(), conversion_options.decimal_separator_symbol);
 
             if (parsed_fractional.empty())
                 number += "0";
@@ -610,6 +615,53 @@ namespace num
         return number;
     }
 
+    /*
+     * Converts a numeral given as term identifiers to a number, e.g. as emitted by a speech recognizer whose vocabulary
+     * is mapped to term identifiers with find_term_id. The result is the same as converting the rendered numeral, but
+     * the numeral is neither tokenized nor are its terms looked up by their text.
+     * \param numeral The term identifiers of the numeral.
+     * \returns the number.
+     * \throws std::invalid_argument exception if the numeral is empty or invalid.
+     */
+    std::string converter_c::to_number(std::span<const term_id_t> numeral)
+    {
+        if (_shadow_engine && _shadow_engine->sample())
+            return _shadow_engine->run("to_number", render_numeral(numeral), _conversion_options,
+                                       [&]() { return convert_to_number(numeral); });
+
+        return convert_to_number(numeral);
+    }
+
+    std::string converter_c::convert_to_number(std::span<const term_id_t> numeral)
+    {
+        if (numeral.empty())
+            throw std::invalid_argument("the numeral must not be empty");
+
+        const auto point = std::find(numeral.begin(), numeral.end(), term_point);
+        if (point != numeral.end())
+        {
+            // As in text, "point" needs to be followed by the fractional part.
+            if (std::next(point) == numeral.end())
+                throw std::invalid_argument("\"point\" is not a valid term");
+
+            if (std::find(std::next(point), numeral.end(), term_point) != numeral.end())
+                throw std::logic_error("\"point\" is only allowed once in a numeral as a decimal separator");
+        }
+
+        auto number = parse_integral_number(numeral.first(point - numeral.begin()), _conversion_options);
+
+        if (point != numeral.end())
+        {
+            if (number.empty())
+                number = "0";
+
+            number.insert(number.end(), _conversion_options.decimal_separator_symbol);
+            number += parse_fractional_number(numeral.subspan(point - numeral.begin() + 1));
+        }
+
+        return number;
+    }
+
     /*
      * Checks whether the given input is likely a numeral. Attention: You are better off checking whether the given
      * input is a valid number before, because numerals also allow simple positive numbers that have no thousands
@@ -620,6 +672,9 @@ namespace num
      */
     bool converter_c::is_numeral(const std::string_view &input)
     {
+        if (is_german(_conversion_options))
+            return is_german_numeral(input);
+
         return std::regex_match(std::string(input), _numeral_pattern) && input != "negative" && input != "minus";
     }
 
@@ -645,7 +700,7 @@ namespace num
         bool negative;
         std::string integral_part, fractional_part;
         int32_t exponent;
-        return extract_number_parts(std::string(input), negative, integral_part, fractional_part, exponent);
+        return extract_number_parts(input, negative, integral_part, fractional_part, exponent, false);
     }
     
     /*
@@ -669,10 +724,10 @@ namespace num
      *   separators.
      * \param out_fractional_part A string that receives the fractional part of the number (if any).
      * \param out_exponent An integer that receives the exponent (power) of the number.
-     * \param resolve_exponent Whether the decimal point shall be moved according to the number's exponent.
+     * \param resolve_exponent Whether the decimal point shall be moved according to the number's exponent. If not, an
+     *   exponent out of the supported range is clamped to one beyond that range, which check_exponent_range rejects.
      * \returns True if the input represents a valid number, false otherwise.
-     * \throws std::invalid_argument exception (see std::stoi).
-     * \throws std::out_of_range exception (see std::stoi).
+     * \throws std::out_of_range exception if the exponent is to be resolved but is out of the supported range.
      */
     bool converter_c::extract_number_parts(const std::string_view &input, bool &out_negative,
                                            std::string &out_integral_part, std::string &out_fractional_part,
@@ -696,7 +751,26 @@ namespace num
                 
             std::string integral_part = has_integral_part ? matches[INTEGRAL].str() : "";
             std::string fractional_part = has_fractional_part ? matches[FRACTIONAL].str() : "";
-            auto exponent = has_exponent ? std::stoi(matches[EXPONENT].str()) : 0;
+            int32_t exponent = 0;
+
+            if (has_exponent)
+            {
+                const auto exponent_begin = &*matches[EXPONENT].first;
+                const auto exponent_end = exponent_begin + matches[EXPONENT].length();
+                const auto [end, error] = std::from_chars(exponent_begin, exponent_end, exponent);
+
+                if (error != std::errc() || exponent > max_exponent || exponent < -max_exponent)
+                {
+                    if (resolve_exponent)
+                    {
+                        const auto message = boost::format("the exponent %1% is out of the supported range of "
+                                                           "-%2% to %2%") % matches[EXPONENT].str() % max_exponent;
+                        throw std::out_of_range(message.str());
+                    }
+
+                    exponent = *exponent_begin == '-' ? -max_exponent - 1 : max_exponent + 1;
+                }
+            }
 
             strip_thousands_separators(integral_part, _conversion_options.thousands_separator_symbol);
 
@@ -748,165 +822,236 @@ namespace num
         return false;
     }
 
-    std::string parse_integral_numeral(const std::string_view &integral, const conversion_options_t &conversion_options)
+    /*
+     * Appends the terms of the value of a group below ten thousand, e.g. "twelve hundred thirty-four" for a group of
+     * four places in the myriad system; groups of up to three places have at most nine hundreds.
+     */
+    void append_group_terms(const int value, std::vector<term_id_t> &terms)
     {
-        if (integral.empty())
-            return {};
+        const auto append_below_hundred = [&](const int below_hundred) {
+            if (below_hundred >= 20)
+            {
+                terms.push_back(tens_term(below_hundred / 10));
+                if (below_hundred % 10 > 0)
+                    terms.push_back(unit_term(below_hundred % 10));
+            }
+            else if (below_hundred > 0)
+                terms.push_back(unit_term(below_hundred));
+        };
 
-        std::stringstream ss;
-        std::size_t place = integral.size() - 1;
-        auto it = integral.begin();
+        if (value >= 100)
+        {
+            append_below_hundred(value / 100);
+            terms.push_back(term_hundred);
+        }
 
-        auto group_digits = std::string();
-        bool any_group_digit_not_zero = false;
-        bool added_two_digits_term = false;
+        append_below_hundred(value % 100);
+    }
 
-        for (; it != integral.end(); it++, place--)
+    void append_integral_numeral_terms(const std::string_view &integral, const conversion_options_t &conversion_options,
+                                       std::vector<term_id_t> &terms)
+    {
+        if (integral == "0")
         {
-            const auto digit = *it;
-            const auto group_place = place % 3;
-
-            if (group_place == 2)
-            {
-                group_digits.clear();
-                any_group_digit_not_zero = false;
-                added_two_digits_term = false;
-            }
+            terms.push_back(unit_term(0));
+            return;
+        }
 
-            group_digits += digit;
-            any_group_digit_not_zero |= digit != '0';
+        const auto &naming_system_table = get_naming_system_table(conversion_options.naming_system);
 
-            //std::cout << digit << " : " << group_place << " : " << place << "\n";
+        if (integral.size() > naming_system_table.max_places())
+        {
+            const auto message = boost::format("numbers of more than %1% integral places are not supported in the %2% "
+                                               "naming system") % naming_system_table.max_places()
+                                               % naming_system_table.name;
+            throw std::logic_error(message.str());
+        }
 
-            auto value = std::string();
-            if (digit != '0' || integral == "0") value += digit;
+        // Groups are counted from the least significant one, each followed by the scale word of its place.
+        for (auto group = naming_system_table.groups_count(); group-- > 0;)
+        {
+            const auto group_place = naming_system_table.group_places[group];
+            if (group_place >= integral.size())
+                continue;
 
-            if (digit != '0' && group_place == 1)
-            {
-                // Get next digit as well because we need that for 2-digit base terms (e.g. thirteen or fourty)
-                const auto next_digit = *std::next(it);
-                value += next_digit;
-            }
+            const auto group_end = integral.size() - group_place;
+            const auto group_size = naming_system_table.group_size(group);
+            const auto group_begin = group_end >= group_size ? group_end - group_size : 0;
 
-            // Encode actual number term.
-            if (!value.empty() && !added_two_digits_term)
+            int value = 0;
+            for (auto i = group_begin; i < group_end; i++)
             {
-                const auto value_term_pair_it = value_to_term.left.find(value);
-                if (value_term_pair_it != value_to_term.left.end())
-                {
-                    ss << value_term_pair_it->second << " ";
-                    added_two_digits_term |= value.size() == 2;
-                }
-                else if (value.size() == 2)
+                if (integral[i] < '0' || integral[i] > '9')
                 {
-                    value[1] = '0';
-                    const auto value_term_pair_it = value_to_term.left.find(value);
-                    if (value_term_pair_it != value_to_term.left.end())
-                    {
-                        ss << value_term_pair_it->second << "-";
-                    }
-                    else
-                    {
-                        const auto message = boost::format("unable to resolve term for value \"%1%\"") % value;
-                        throw std::logic_error(message.str());
-                    }
-                }
-                else
-                {
-                    const auto message = boost::format("unable to resolve term for value \"%1%\"") % value;
+                    const auto message = boost::format("unable to resolve term for value \"%1%\"") % integral[i];
                     throw std::logic_error(message.str());
                 }
+
+                value = value * 10 + (integral[i] - '0');
             }
 
-            // Encode an "-illion" or "-illiard" term.
-            if (any_group_digit_not_zero && place >= 6 && group_place == 0)
-            {
-                const auto factor = conversion_options.naming_system == naming_system_t::short_scale ?
-                                    (place - 3) / 3 : place / 6;
-                const auto remainder = conversion_options.naming_system == naming_system_t::short_scale ?
-                                       0 : place % 6;
+            if (value == 0)
+                continue;
 
-                if (factor > 100)
-                    throw std::logic_error("latin roots greater than \"centillion\" are not supported");
+            append_group_terms(value, terms);
 
-                const auto &factor_root_pair_it = factor_to_root.left.find(factor);
-                if (factor_root_pair_it != factor_to_root.left.end())
-                {
-                    ss << factor_root_pair_it->second << (remainder == 3 ? "illiard " : "illion ");
-                }
-                else
-                {
-                    const auto prefix_value = factor % 10;
-                    const auto &value_prefix_pair_it = value_to_prefix.left.find(prefix_value);
-                    if (value_prefix_pair_it != value_to_prefix.left.end())
-                    {
-                        const auto base_factor = factor - prefix_value;
-                        const auto &base_factor_root_pair_it = factor_to_root.left.find(base_factor);
-                        if (base_factor_root_pair_it != factor_to_root.left.end())
-                        {
-                            ss << value_prefix_pair_it->second << base_factor_root_pair_it->second
-                               << (remainder == 3 ? "illiard " : "illion ");
-                        }
-                        else
-                        {
-                            const auto message = boost::format("unable to resolve latin root for base factor %1%")
-                                                               % base_factor;
-                            throw std::logic_error(message.str());
-                        }
-                    }
-                    else
-                    {
-                        const auto message = boost::format("unable to resolve latin prefix for value %1%")
-                                                           % prefix_value;
-                        throw std::logic_error(message.str());
-                    }
-                }
-            }
-            else if (any_group_digit_not_zero && place == 3)
-            {
-                ss << "thousand ";
-            }
-            else if (digit != '0' && group_place == 2)
+            if (group > 0)
+                terms.push_back(naming_system_table.group_terms[group]);
+        }
+    }
+
+    void append_fractional_numeral_terms(const std::string_view &fractional, std::vector<term_id_t> &terms)
+    {
+        for (const auto digit : fractional)
+        {
+            if (digit < '0' || digit > '9')
             {
-                ss << "hundred ";
+                const auto message = boost::format("unable to resolve term for value \"%1%\"") % digit;
+                throw std::logic_error(message.str());
             }
+
+            terms.push_back(unit_term(digit - '0'));
         }
+    }
+
+    void append_numeral_terms(const bool negative, const std::string_view &integral, const std::string_view &fractional,
+                              const conversion_options_t &conversion_options, std::vector<term_id_t> &terms)
+    {
+        if (negative)
+            terms.push_back(term_negative);
 
-        auto result = ss.str();
-        rtrim(result);
+        // A zero integral part is left out if it is the leading term and no leading zero is forced.
+        if (!integral.empty() && (negative || integral != "0" || conversion_options.force_leading_zero))
+            append_integral_numeral_terms(integral, conversion_options, terms);
 
-        return result;
+        if (!fractional.empty())
+        {
+            terms.push_back(term_point);
+            append_fractional_numeral_terms(fractional, terms);
+        }
     }
 
-    std::string parse_fractional_numeral(const std::string_view &fractional, const conversion_options_t &conversion_options)
+    std::string parse_integral_numeral(const std::string_view &integral, const conversion_options_t &conversion_options)
     {
-        if (fractional.empty())
-            return {};
+        std::vector<term_id_t> terms;
+        append_integral_numeral_terms(integral, conversion_options, terms);
+        return render_numeral(terms);
+    }
 
-        std::stringstream ss;
+    /*
+     * Finds the term identifier of the given term text, e.g. for mapping the vocabulary of a speech recognizer to term
+     * identifiers once.
+     * \param text the text of the term, e.g. "million".
+     * \returns the term identifier if the text is a term of the lexicon; an empty optional otherwise.
+     */
+    std::optional<term_id_t> find_term_id(const std::string_view &text)
+    {
+        const auto text_term_id_pair_it = text_to_term_id.find(text);
+        if (text_term_id_pair_it == text_to_term_id.end())
+            return std::nullopt;
 
-        for (const auto digit : fractional)
+        return text_term_id_pair_it->second;
+    }
+
+    /*
+     * Gets the additive value of the given unit, teen or ten term, e.g. "20" for "twenty".
+     */
+    std::string_view find_term_value(const term_id_t term)
+    {
+        return term_values[term];
+    }
+
+    /*
+     * Gets the text of the given term.
+     * \param term the term identifier.
+     * \returns the text of the term, e.g. "million".
+     * \throws std::invalid_argument exception if the term identifier is not valid.
+     */
+    std::string_view term_text(const term_id_t term)
+    {
+        if (term >= terms_count)
         {
-            const auto value = std::string(1, digit);
-            const auto value_term_pair_it = value_to_term.left.find(value);
-            if (value_term_pair_it != value_to_term.left.end())
-            {
-                ss << value_term_pair_it->second << " ";
-            }
-            else
+            const auto message = boost::format("%1% is not a valid term identifier") % static_cast<int>(term);
+            throw std::invalid_argument(message.str());
+        }
+
+        return term_texts[term];
+    }
+
+    /*
+     * Renders a numeral given as term identifiers as text. Terms are separated by spaces, except for tens and units,
+     * which are joined by hyphens, e.g. "twenty-one".
+     * \param terms the term identifiers of the numeral.
+     * \returns the numeral.
+     * \throws std::invalid_argument exception if any term identifier is not valid.
+     */
+    std::string render_numeral(std::span<const term_id_t> terms)
+    {
+        std::string numeral;
+        numeral.reserve(terms.size() * 8);
+
+        for (std::size_t i = 0; i < terms.size(); i++)
+        {
+            const auto text = term_text(terms[i]);
+
+            if (i > 0)
             {
-                const auto message = boost::format("unable to resolve term for value \"%1%\"") % value;
-                throw std::logic_error(message.str());
+                const auto previous = terms[i - 1];
+                const auto joined = previous >= tens_term(2) && previous <= tens_term(9) &&
+                                    terms[i] >= unit_term(1) && terms[i] <= unit_term(9);
+                numeral += joined ? '-' : ' ';
             }
+
+            numeral += text;
         }
 
-        auto result = ss.str();
-        rtrim(result);
+        return numeral;
+    }
+
+    std::string converter_c::to_numeral(const std::string_view &number)
+    {
+        std::string result;
+        const auto fingerprint = _result_cache ? result_cache_c::fingerprint(_conversion_options, "to_numeral") : 0;
+
+        if (_result_cache && _result_cache->find(fingerprint, number, result))
+            return result;
+
+        if (_shadow_engine && _shadow_engine->sample())
+            result = _shadow_engine->run("to_numeral", number, _conversion_options,
+                                         [&]() { return convert_to_numeral(number); });
+        else
+            result = convert_to_numeral(number);
+
+        if (_result_cache)
+            _result_cache->insert(fingerprint, number, result);
 
         return result;
     }
 
-    std::string converter_c::to_numeral(const std::string_view &number)
+    std::vector<term_id_t> converter_c::to_numeral_terms(const std::string_view &number)
+    {
+        return convert_to_numeral_terms(number);
+    }
+
+    std::string converter_c::convert_to_numeral(const std::string_view &number)
+    {
+        if (is_german(_conversion_options))
+        {
+            bool negative = false;
+            std::string integral_part;
+            std::string fractional_part;
+            int32_t exponent = 0;
+
+            if (number.empty() || !extract_number_parts(number, negative, integral_part, fractional_part, exponent))
+                return {};
+
+            return render_german_numeral(negative, integral_part, fractional_part, _conversion_options);
+        }
+
+        return render_numeral(convert_to_numeral_terms(number));
+    }
+
+    std::vector<term_id_t> converter_c::convert_to_numeral_terms(const std::string_view &number)
     {
         if (number.empty())
             return {};
@@ -919,41 +1064,65 @@ namespace num
         if (!extract_number_parts(number, negative, integral_part, fractional_part, exponent))
             return {};
 
-        std::string numeral;
-        
-        if (negative)
-            numeral = "negative";
+        std::vector<term_id_t> terms;
+        append_numeral_terms(negative, integral_part, fractional_part, _conversion_options, terms);
+        return terms;
+    }
 
-        if (!integral_part.empty())
-        {
-            const auto parsed_integral = parse_integral_numeral(integral_part, _conversion_options);
-            if (!parsed_integral.empty())
-            {
-                if (numeral.empty() && (integral_part != "0" || _conversion_options.force_leading_zero))
-                    numeral = parsed_integral;
-                else if (!numeral.empty())
-                    numeral += " " + parsed_integral;
-            }
-        }
+    std::string converter_c::convert(const std::string_view &input)
+    {
+        return is_number(input) ? to_numeral(input) : to_number(input);
+    }
 
-        if (!fractional_part.empty())
-        {
-            const auto parsed_fractional = parse_fractional_numeral(fractional_part, _conversion_options);
-            if (!parsed_fractional.empty())
-            {
-                if (numeral.empty())
-                    numeral = "point " + parsed_fractional;
-                else
-                    numeral += " point " + parsed_fractional;
-            }
-        }
+    /*
+     * Enables the shadow mode: the given fraction of all following conversions is additionally run through the
+     * reference engine in the background, and every difference in outcome is passed to the mismatch handler (or
+     * written to the standard error output if no handler is given). Copies of this converter share the shadow mode.
+     *
+     * \param sample_rate The fraction of conversions to be compared, between 0 (none) and 1 (all).
+     * \param mismatch_handler The handler to be called on the background thread for each mismatch.
+     * \throws std::invalid_argument exception if the sample rate is out of range.
+     */
+    void converter_c::enable_shadow_mode(double sample_rate, shadow_mismatch_handler_t mismatch_handler)
+    {
+        _shadow_engine = std::make_shared<shadow_engine_c>(sample_rate, std::move(mismatch_handler));
+    }
 
-        return numeral;
+    /*
+     * Disables the shadow mode after all pending comparisons have finished.
+     */
+    void converter_c::disable_shadow_mode()
+    {
+        _shadow_engine.reset();
     }
 
-    std::string converter_c::convert(const std::string_view &input)
+    /*
+     * Blocks until all conversions sampled so far have been compared against the reference engine.
+     */
+    void converter_c::flush_shadow_mode()
     {
-        return is_number(input) ? to_numeral(input) : to_number(input);
+        if (_shadow_engine)
+            _shadow_engine->flush();
+    }
+
+    shadow_statistics_t converter_c::shadow_statistics() const
+    {
+        return _shadow_engine ? _shadow_engine->statistics() : shadow_statistics_t();
+    }
+
+    /*
+     * Enables the result cache: the results of all following conversions of text through to_number and to_numeral are
+     * looked up in the given cache first and added to it otherwise. The cache may be shared by several converters.
+     * \param result_cache The result cache.
+     */
+    void converter_c::enable_result_cache(std::shared_ptr<result_cache_c> result_cache)
+    {
+        _result_cache = std::move(result_cache);
+    }
+
+    void converter_c::disable_result_cache()
+    {
+        _result_cache.reset();
     }
 
     converter_c::converter_c() :
@@ -0,0 +1,439 @@
+#ifndef NUMERO_PARSER_H
+#define NUMERO_PARSER_H
+
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "numero/numero.h"
+#include "naming_system.h"
+
+namespace num
+{
+    std::string_view find_additive_value(const std::string_view &term, int max_allowed_digits,
+                                         bool allow_numbers_greater_99);
+    uint32_t find_multiplicative_shift(const std::string_view &term, const conversion_options_t &conversion_options);
+    std::string_view find_term_value(term_id_t term);
+    void merge_places(const std::string_view &source, std::string &target);
+    void shift_places(const uint32_t places_count, std::string &target);
+    void add_thousands_separators(std::string &target, const char thousands_separator_symbol);
+
+    /*
+     * Parses the integral part of a numeral term by term. Terms are classified by the caller, so that the same rules
+     * apply to numerals given as text and as term identifiers. The texts of the terms are only needed for debug output
+     * and error messages and are requested from the given accessor by the position of the term.
+     */
+    template <class TermText>
+    class integral_number_parser_c
+    {
+    public:
+        integral_number_parser_c(const conversion_options_t &conversion_options, TermText term_text) :
+            _conversion_options(conversion_options),
+            _term_text(std::move(term_text))
+        {
+        }
+
+        /*
+         * Whether no number term has been pushed yet, i.e. whether the article "a", the signs "negative" and "minus"
+         * and digit terms greater than 99 are allowed.
+         */
+        inline bool at_beginning() const {
+            return _groups.empty() && _current_group.empty();
+        }
+
+        inline bool negative() const {
+            return _negative;
+        }
+
+        inline const std::vector<std::string> &groups() const {
+            return _groups;
+        }
+
+        inline const std::string &current_group() const {
+            return _current_group;
+        }
+
+        /*
+         * Checks whether the terms so far can still be continued to a valid integral part. The total multiplicative
+         * shift of the current group only ever grows, so once it is not less than that of the last group, no further
+         * terms can make up for it.
+         * \throws std::invalid_argument exception with the same message as finish() if not.
+         */
+        void check() const
+        {
+            check_group_order(_multiplicative_terms.size());
+        }
+
+        void push_article()
+        {
+            begin_term();
+            _current_group = "1";
+            end_term(false);
+        }
+
+        void push_sign()
+        {
+            begin_term();
+            _negative = true;
+            end_term(false);
+        }
+
+        void push_additive(const std::string_view &additive_value)
+        {
+            begin_term();
+
+            const auto position = _multiplicative_terms.size();
+
+            if (_last_term_multiplicative && _last_multiplicative_shift >= 3)
+            {
+                check_group_order(position);
+
+                _groups.push_back(_current_group);
+
+                if (_conversion_options.debug_output)
+                {
+                    std::cout << "Group number: " << _current_group << "\n";
+                    std::cout << "New group" << "\n";
+                }
+
+                _current_group.clear();
+                _last_sub_numeral_begin = _current_sub_numeral_begin;
+                _last_sub_numeral_end = position;
+                _current_sub_numeral_begin = position;
+                _last_group_total_multiplicative_shift = _current_group_total_multiplicative_shift;
+                _current_group_total_multiplicative_shift = 0;
+                _last_multiplicative_shift = 0;
+            }
+
+            if (_conversion_options.debug_output)
+            {
+                std::cout << "Term: " << _term_text(position) << "\n";
+                std::cout << "  Additive value: " << additive_value << "\n";
+            }
+
+            _last_term_multiplicative = false;
+
+            if (_last_additive_value_size > 0 && _last_additive_value_size < additive_value.size())
+            {
+                const auto message = boost::format("greater value terms have to precede lower value terms. "
+                                                   "Did you mean \"%1% %2%\"?") % _term_text(position)
+                                                   % _term_text(position - 1);
+                throw std::invalid_argument(message.str());
+            }
+
+            merge_places(additive_value, _current_group);
+
+            _last_additive_value_size = additive_value.size();
+            end_term(false);
+        }
+
+        void push_multiplicative(const uint32_t multiplicative_shift)
+        {
+            begin_term();
+
+            const auto position = _multiplicative_terms.size();
+
+            if (multiplicative_shift < _last_multiplicative_shift)
+            {
+                const auto message = boost::format("a lower multiplicative term is not allowed to follow a "
+                                                   "higher multiplicative term: \"%1% %2%\". "
+                                                   "Did you mean \"%2% %1%\" or did you forget an additive term "
+                                                   "in front of \"%2%\"?") % _term_text(position - 1)
+                                                   % _term_text(position);
+                throw std::invalid_argument(message.str());
+            }
+
+            // Add an implicit 1 if that is missing at the beginning of the numeral.
+            if (at_beginning())
+                _current_group = "1";
+
+            if (_current_group == "0")
+                throw std::invalid_argument("in the integral part \"zero\" is only allowed on its own.");
+
+            if (_conversion_options.debug_output)
+            {
+                std::cout << "Term: " << _term_text(position) << "\n";
+                std::cout << "  Multiplicative value: 10^" << multiplicative_shift << "\n";
+            }
+
+            _last_term_multiplicative = true;
+            _last_multiplicative_shift = multiplicative_shift;
+            _current_group_total_multiplicative_shift += multiplicative_shift;
+
+            shift_places(multiplicative_shift, _current_group);
+
+            _last_additive_value_size = 0;
+            end_term(true);
+        }
+
+        std::string finish()
+        {
+            auto result = finish_digits();
+
+            if (_conversion_options.use_thousands_separators)
+                add_thousands_separators(result, _conversion_options.thousands_separator_symbol);
+
+            if (_negative)
+                result.insert(0, 1, '-');
+
+            return result;
+        }
+
+        /*
+         * Finishes the integral part like finish(), but merges its groups into its bare digits, i.e. without the sign
+         * and thousands separators, e.g. for comparing or hashing its value.
+         */
+        std::string finish_digits()
+        {
+            if (at_beginning() && _negative)
+                throw std::invalid_argument("the numeral must not be empty");
+
+            check_group_order(_multiplicative_terms.size());
+
+            _groups.push_back(_current_group);
+
+            std::string digits;
+
+            for (const auto &group : _groups)
+                merge_places(group, digits);
+
+            return digits;
+        }
+
+    private:
+        void begin_term()
+        {
+            // At the beginning, each term starts the current sub numeral anew.
+            if (at_beginning())
+                _current_sub_numeral_begin = _multiplicative_terms.size();
+        }
+
+        void end_term(const bool multiplicative)
+        {
+            _multiplicative_terms.push_back(multiplicative);
+        }
+
+        /*
+         * Checks that the current group is of lower magnitude than the last one, as a group of the same magnitude is a
+         * duplicate and one of higher magnitude has to precede it.
+         */
+        void check_group_order(const std::size_t position) const
+        {
+            if (_current_group_total_multiplicative_shift == _last_group_total_multiplicative_shift)
+            {
+                const auto message = boost::format("there must not be multiple sub numerals with the same magnitude: "
+                                                   "\"%1%\" and \"%2%\".") % last_sub_numeral()
+                                                   % sub_numeral(_current_sub_numeral_begin, position);
+                throw std::invalid_argument(message.str());
+            }
+            else if (_current_group_total_multiplicative_shift > _last_group_total_multiplicative_shift)
+            {
+                const auto message = boost::format("a higher magnitude sub numeral is not allowed to follow a "
+                                                   "lower magnitude sub numeral: \"%1%\" follows \"%2%\". "
+                                                   "Did you mean \"%1% %2%\"?")
+                                                   % sub_numeral(_current_sub_numeral_begin, position)
+                                                   % last_sub_numeral();
+                throw std::invalid_argument(message.str());
+            }
+        }
+
+        /*
+         * Names a sub numeral in error messages by its first term followed by all of its multiplicative terms, e.g.
+         * "two hundred million" for "two hundred five million".
+         */
+        std::string sub_numeral(const std::size_t begin, const std::size_t end) const
+        {
+            std::string sub_numeral(_term_text(begin));
+            for (auto position = begin; position < end; position++)
+            {
+                if (_multiplicative_terms[position])
+                    sub_numeral.append(1, ' ').append(_term_text(position));
+            }
+            return sub_numeral;
+        }
+
+        std::string last_sub_numeral() const
+        {
+            return _last_sub_numeral_end > 0 ? sub_numeral(_last_sub_numeral_begin, _last_sub_numeral_end) :
+                                               std::string();
+        }
+
+    private:
+        const conversion_options_t &_conversion_options;
+        TermText _term_text;
+
+        bool _negative = false;
+        std::vector<std::string> _groups;
+        std::string _current_group;
+        std::vector<bool> _multiplicative_terms;
+        std::size_t _current_sub_numeral_begin = 0;
+        std::size_t _last_sub_numeral_begin = 0;
+        std::size_t _last_sub_numeral_end = 0;
+        std::size_t _last_additive_value_size = 0;
+
+        uint32_t _last_multiplicative_shift = 0;
+        uint32_t _last_group_total_multiplicative_shift = std::numeric_limits<uint32_t>::max();
+        uint32_t _current_group_total_multiplicative_shift = 0;
+        bool _last_term_multiplicative = false;
+    };
+
+    /*
+     * Classifies a term of the integral part of a numeral given as text and pushes it to the parser.
+     * \throws std::invalid_argument exception if the term is neither additive nor multiplicative or if it violates the
+     *   rules of the numeral so far.
+     */
+    template <class Parser>
+    void push_integral_term(Parser &parser, const std::string_view &term, const conversion_options_t &conversion_options)
+    {
+        if (parser.at_beginning())
+        {
+            if (term == "a")
+            {
+                parser.push_article();
+                return;
+            }
+            else if (term == "negative" || term == "minus")
+            {
+                parser.push_sign();
+                return;
+            }
+        }
+
+        std::exception_ptr find_additive_value_exception = nullptr;
+        std::exception_ptr find_multiplicative_shift_exception = nullptr;
+
+        std::string_view current_additive_value;
+        uint32_t current_multiplicative_shift = 0;
+
+        try {
+            current_additive_value = find_additive_value(term, 3, parser.at_beginning());
+        } catch (const std::exception &e) {
+            find_additive_value_exception = std::current_exception();
+        }
+
+        try {
+            current_multiplicative_shift = find_multiplicative_shift(term, conversion_options);
+        } catch (const std::exception &e) {
+            find_multiplicative_shift_exception = std::current_exception();
+        }
+
+        // If the term is neither additive nor multiplicative, tell the term is unknown, or not part of the naming system.
+        if (find_additive_value_exception && find_multiplicative_shift_exception)
+            std::rethrow_exception(find_term_id(term) ? find_multiplicative_shift_exception :
+                                                        find_additive_value_exception);
+
+        if (!find_additive_value_exception)
+            parser.push_additive(current_additive_value);
+        else
+            parser.push_multiplicative(current_multiplicative_shift);
+    }
+
+    /*
+     * Classifies a term of the integral part of a numeral given as term identifier and pushes it to the parser. Terms
+     * are classified by table lookups only; the rules are the same as for terms given as text.
+     * \throws std::invalid_argument exception if the term is not valid at this place or if it violates the rules of
+     *   the numeral so far.
+     */
+    template <class Parser>
+    void push_integral_term(Parser &parser, const term_id_t term, const conversion_options_t &conversion_options)
+    {
+        const auto &naming_system_table = get_naming_system_table(conversion_options.naming_system);
+        const auto shift = term < terms_count ? naming_system_table.shifts[term] : 0;
+
+        if (term <= tens_term(9))
+        {
+            parser.push_additive(find_term_value(term));
+        }
+        else if (shift > 0)
+        {
+            parser.push_multiplicative(shift);
+        }
+        else if ((term == term_negative || term == term_minus) && parser.at_beginning())
+        {
+            parser.push_sign();
+        }
+        else if (term == term_a && parser.at_beginning())
+        {
+            parser.push_article();
+        }
+        else if (term > term_a && term < terms_count)
+        {
+            // The term is not multiplicative in the naming system, which is told as for the term given as text.
+            find_multiplicative_shift(term_text(term), conversion_options);
+
+            const auto message = boost::format("\"%1%\" is not a term of the %2% naming system") % term_text(term)
+                                               % naming_system_table.name;
+            throw std::invalid_argument(message.str());
+        }
+        else
+        {
+            const auto message = boost::format("\"%1%\" is not a valid term") % term_text(term);
+            throw std::invalid_argument(message.str());
+        }
+    }
+
+    /*
+     * Classifies a term of the integral part of a numeral given as text by its term identifier and pushes it to the
+     * parser, just like a term given as term identifier. Terms that are not valid there, e.g. numbers and unknown terms,
+     * are classified by their text, so that the results and errors are the same as for converting the numeral.
+     */
+    template <class Parser>
+    void push_integral_term_by_id(Parser &parser, const std::string_view &term,
+                                  const conversion_options_t &conversion_options)
+    {
+        const auto term_id = find_term_id(term);
+
+        if (term_id)
+        {
+            const auto &naming_system_table = get_naming_system_table(conversion_options.naming_system);
+            const auto at_beginning_only = *term_id == term_negative || *term_id == term_minus || *term_id == term_a;
+
+            if (*term_id <= tens_term(9) || naming_system_table.shifts[*term_id] > 0 ||
+                (at_beginning_only && parser.at_beginning()))
+            {
+                push_integral_term(parser, *term_id, conversion_options);
+                return;
+            }
+        }
+
+        push_integral_term(parser, term, conversion_options);
+    }
+
+    /*
+     * Appends the digit of a term of the fractional part of a numeral given as text.
+     */
+    inline void append_fractional_term(const std::string_view &term, std::string &target)
+    {
+        target += find_additive_value(term, 1, true);
+    }
+
+    /*
+     * Appends the digit of a term of the fractional part of a numeral given as term identifier.
+     */
+    inline void append_fractional_term(const term_id_t term, std::string &target)
+    {
+        if (term <= unit_term(9))
+        {
+            target += find_term_value(term);
+        }
+        else if (term <= tens_term(9))
+        {
+            const auto message = boost::format("\"%1%\" is not allowed at this place") % term_text(term);
+            throw std::invalid_argument(message.str());
+        }
+        else
+        {
+            const auto message = boost::format("\"%1%\" is not a valid term") % term_text(term);
+            throw std::invalid_argument(message.str());
+        }
+    }
+};
+
+#endif //NUMERO_PARSER_H
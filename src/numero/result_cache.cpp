@@ -0,0 +1,371 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NUMERO_USE_MMAP 1
+#endif
+
+#include "numero/result_cache.h"
+#include "german.h"
+#include "naming_system.h"
+
+namespace num
+{
+    static_assert(std::atomic_ref<uint64_t>::is_always_lock_free);
+
+    namespace
+    {
+        constexpr uint32_t result_cache_byte_order = 0x01020304;
+        constexpr uint64_t offset_bits = 40;
+        constexpr uint64_t offset_mask = (uint64_t(1) << offset_bits) - 1;
+
+        struct entry_header_t
+        {
+            uint64_t fingerprint;
+            uint32_t input_size;
+            uint32_t result_size;
+        };
+
+        uint64_t fnv1a(const void *data, const std::size_t size, uint64_t hash = 0xcbf29ce484222325)
+        {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            for (std::size_t i = 0; i < size; i++)
+                hash = (hash ^ bytes[i]) * 0x100000001b3;
+            return hash;
+        }
+
+        inline uint64_t hash_key(const uint64_t fingerprint, const std::string_view &input)
+        {
+            return fnv1a(input.data(), input.size(), fnv1a(&fingerprint, sizeof(fingerprint)));
+        }
+
+        inline uint64_t align(const uint64_t size)
+        {
+            return (size + 7) & ~uint64_t(7);
+        }
+
+        void throw_io_error(const char *what, const std::string &path)
+        {
+            const auto message = boost::format("unable to %1% result cache file \"%2%\": %3%") % what % path
+                                               % std::strerror(errno);
+            throw std::runtime_error(message.str());
+        }
+    }
+
+    /*
+     * Opens the result cache file at the given path, or creates it if it does not exist yet or if it is outdated, e.g.
+     * because the lexicon has changed since it was created. A new file is prepared under a temporary name and then
+     * renamed, so that other processes never open an incomplete one.
+     * \param path The path of the cache file.
+     * \param slots_count The number of slots of a new cache file; rounded up to a power of two.
+     * \param data_capacity The size of the data area of a new cache file in bytes.
+     * \throws std::runtime_error exception if the file can neither be opened nor created.
+     */
+    result_cache_c::result_cache_c(const std::string &path, const uint64_t slots_count, const uint64_t data_capacity)
+    {
+#ifdef NUMERO_USE_MMAP
+        if (!open(path))
+            create(path, std::bit_ceil(std::max<uint64_t>(slots_count, 2)),
+                   std::min(align(data_capacity), offset_mask << 3));
+#else
+        throw std::runtime_error("result caches require memory-mapped files, which are not supported on this platform");
+#endif
+    }
+
+    result_cache_c::~result_cache_c()
+    {
+        release();
+    }
+
+    bool result_cache_c::open(const std::string &path)
+    {
+#ifdef NUMERO_USE_MMAP
+        const auto fd = ::open(path.c_str(), O_RDWR);
+        if (fd < 0)
+            return false;
+
+        struct stat status;
+        if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(result_cache_header_t))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        _size = static_cast<std::size_t>(status.st_size);
+        auto *mapping = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (mapping == MAP_FAILED)
+            throw_io_error("map", path);
+
+        _data = static_cast<char *>(mapping);
+        _header = reinterpret_cast<result_cache_header_t *>(_data);
+
+        const auto valid = std::memcmp(_header->magic, result_cache_magic, sizeof(result_cache_magic)) == 0 &&
+                           _header->version == result_cache_version &&
+                           _header->byte_order == result_cache_byte_order &&
+                           _header->lexicon_stamp == lexicon_stamp() &&
+                           std::has_single_bit(_header->slots_count) &&
+                           _header->data_offset == sizeof(result_cache_header_t) + _header->slots_count * 8 &&
+                           _header->data_offset + _header->data_capacity == _size;
+
+        if (!valid)
+        {
+            release();
+            return false;
+        }
+
+        _slots = reinterpret_cast<uint64_t *>(_data + sizeof(result_cache_header_t));
+        _entries = _data + _header->data_offset;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void result_cache_c::create(const std::string &path, const uint64_t slots_count, const uint64_t data_capacity)
+    {
+#ifdef NUMERO_USE_MMAP
+        const auto temporary_path = (boost::format("%1%.%2%.tmp") % path % ::getpid()).str();
+        const auto fd = ::open(temporary_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw_io_error("create", temporary_path);
+
+        // The file is sparse, so that only the pages actually used take up space.
+        const auto data_offset = sizeof(result_cache_header_t) + slots_count * 8;
+        _size = static_cast<std::size_t>(data_offset + data_capacity);
+
+        if (::ftruncate(fd, static_cast<off_t>(_size)) != 0)
+        {
+            ::close(fd);
+            ::unlink(temporary_path.c_str());
+            throw_io_error("resize", temporary_path);
+        }
+
+        auto *mapping = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            ::unlink(temporary_path.c_str());
+            throw_io_error("map", temporary_path);
+        }
+
+        _data = static_cast<char *>(mapping);
+        _header = reinterpret_cast<result_cache_header_t *>(_data);
+        std::memcpy(_header->magic, result_cache_magic, sizeof(result_cache_magic));
+        _header->version = result_cache_version;
+        _header->byte_order = result_cache_byte_order;
+        _header->lexicon_stamp = lexicon_stamp();
+        _header->slots_count = slots_count;
+        _header->data_offset = data_offset;
+        _header->data_capacity = data_capacity;
+        // Offset zero marks empty slots, so that the first entry starts at offset 8.
+        _header->data_size = 8;
+        _header->entries_count = 0;
+
+        _slots = reinterpret_cast<uint64_t *>(_data + sizeof(result_cache_header_t));
+        _entries = _data + data_offset;
+
+        if (::msync(_data, sizeof(result_cache_header_t), MS_SYNC) != 0 ||
+            ::rename(temporary_path.c_str(), path.c_str()) != 0)
+        {
+            release();
+            ::unlink(temporary_path.c_str());
+            throw_io_error("create", path);
+        }
+#endif
+    }
+
+    void result_cache_c::release()
+    {
+#ifdef NUMERO_USE_MMAP
+        if (_data)
+            ::munmap(_data, _size);
+#endif
+        _data = nullptr;
+        _size = 0;
+        _header = nullptr;
+        _slots = nullptr;
+        _entries = nullptr;
+    }
+
+    bool result_cache_c::matches(const uint64_t slot, const uint64_t hash, const uint64_t fingerprint,
+                                 const std::string_view &input) const
+    {
+        if ((slot >> offset_bits) != (hash >> offset_bits))
+            return false;
+
+        const auto offset = (slot & offset_mask) << 3;
+        if (offset + sizeof(entry_header_t) > _header->data_capacity)
+            return false;
+
+        entry_header_t entry;
+        std::memcpy(&entry, _entries + offset, sizeof(entry));
+
+        return entry.fingerprint == fingerprint && entry.input_size == input.size() &&
+               offset + sizeof(entry) + entry.input_size + entry.result_size <= _header->data_capacity &&
+               std::memcmp(_entries + offset + sizeof(entry), input.data(), input.size()) == 0;
+    }
+
+    /*
+     * Looks up the result of a conversion.
+     * \param fingerprint The fingerprint of the conversion, see fingerprint().
+     * \param input The input of the conversion.
+     * \param out_result The string that receives the result if it is cached.
+     * \returns True if the result is cached, false otherwise.
+     */
+    bool result_cache_c::find(const uint64_t fingerprint, const std::string_view &input, std::string &out_result) const
+    {
+        const auto hash = hash_key(fingerprint, input);
+        const auto mask = _header->slots_count - 1;
+
+        for (uint64_t i = 0; i <= mask; i++)
+        {
+            const auto slot = std::atomic_ref<uint64_t>(_slots[(hash + i) & mask]).load(std::memory_order_acquire);
+            if (slot == 0)
+                return false;
+
+            if (matches(slot, hash, fingerprint, input))
+            {
+                const auto offset = (slot & offset_mask) << 3;
+                entry_header_t entry;
+                std::memcpy(&entry, _entries + offset, sizeof(entry));
+                out_result.assign(_entries + offset + sizeof(entry) + entry.input_size, entry.result_size);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*
+     * Appends the result of a conversion to the cache, unless it is cached already or the cache is full. The entry is
+     * written to the data area first and only then published by claiming a slot.
+     * \param fingerprint The fingerprint of the conversion, see fingerprint().
+     * \param input The input of the conversion.
+     * \param result The result of the conversion.
+     * \returns True if the result is cached afterwards, false if the cache is full.
+     */
+    bool result_cache_c::insert(const uint64_t fingerprint, const std::string_view &input,
+                                const std::string_view &result)
+    {
+        const auto mask = _header->slots_count - 1;
+
+        // Slots are only filled up to three quarters, so that probe sequences stay short.
+        if (std::atomic_ref<uint64_t>(_header->entries_count).load(std::memory_order_relaxed) >=
+            _header->slots_count / 4 * 3)
+            return false;
+
+        const entry_header_t entry { fingerprint, static_cast<uint32_t>(input.size()),
+                                     static_cast<uint32_t>(result.size()) };
+        const auto entry_size = align(sizeof(entry) + input.size() + result.size());
+        const auto offset = std::atomic_ref<uint64_t>(_header->data_size).fetch_add(entry_size,
+                                                                                      std::memory_order_relaxed);
+        if (offset + entry_size > _header->data_capacity)
+            return false;
+
+        std::memcpy(_entries + offset, &entry, sizeof(entry));
+        std::memcpy(_entries + offset + sizeof(entry), input.data(), input.size());
+        std::memcpy(_entries + offset + sizeof(entry) + input.size(), result.data(), result.size());
+
+        const auto hash = hash_key(fingerprint, input);
+        const auto packed = (hash >> offset_bits << offset_bits) | (offset >> 3);
+
+        for (uint64_t i = 0; i <= mask; i++)
+        {
+            std::atomic_ref<uint64_t> slot(_slots[(hash + i) & mask]);
+            auto expected = slot.load(std::memory_order_acquire);
+
+            if (expected == 0 && slot.compare_exchange_strong(expected, packed, std::memory_order_acq_rel))
+            {
+                std::atomic_ref<uint64_t>(_header->entries_count).fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            // Another process may have cached the same result in the meantime.
+            if (matches(expected, hash, fingerprint, input))
+                return true;
+        }
+
+        return false;
+    }
+
+    /*
+     * Gets the number of cached results.
+     */
+    std::size_t result_cache_c::size() const
+    {
+        return std::atomic_ref<uint64_t>(_header->entries_count).load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Computes the fingerprint of a conversion from the operation and all conversion options that affect its result,
+     * so that results of conversions with different options are cached separately.
+     */
+    uint64_t result_cache_c::fingerprint(const conversion_options_t &conversion_options,
+                                         const std::string_view &operation)
+    {
+        const uint8_t options[] = {
+            static_cast<uint8_t>(conversion_options.naming_system),
+            conversion_options.use_scientific_notation,
+            conversion_options.use_thousands_separators,
+            conversion_options.force_leading_zero,
+            static_cast<uint8_t>(conversion_options.thousands_separator_symbol),
+            static_cast<uint8_t>(conversion_options.decimal_separator_symbol)
+        };
+
+        auto hash = fnv1a(operation.data(), operation.size());
+        hash = fnv1a(options, sizeof(options), hash);
+        hash = fnv1a(&conversion_options.max_term_edits, sizeof(conversion_options.max_term_edits), hash);
+        return fnv1a(conversion_options.language.data(), conversion_options.language.size(), hash);
+    }
+
+    /*
+     * Computes the stamp of the lexicon from the texts of all its terms, the morphemes of the German lexicon and the
+     * compiled tables of all naming systems, so that results converted with any other of these are not served.
+     */
+    uint64_t result_cache_c::lexicon_stamp()
+    {
+        static const auto stamp = []() {
+            const uint64_t count = terms_count;
+            uint64_t hash = fnv1a(&count, sizeof(count));
+            for (std::size_t term = 0; term < terms_count; term++)
+            {
+                const auto text = term_text(static_cast<term_id_t>(term));
+                hash = fnv1a(text.data(), text.size(), hash);
+                hash = fnv1a("", 1, hash);
+            }
+
+            const auto german_lexicon = describe_german_lexicon();
+            hash = fnv1a(german_lexicon.data(), german_lexicon.size(), hash);
+
+            for (const auto naming_system : { naming_system_t::short_scale, naming_system_t::long_scale,
+                                              naming_system_t::indian, naming_system_t::myriad })
+            {
+                const auto &table = get_naming_system_table(naming_system);
+                hash = fnv1a(table.shifts.data(), sizeof(table.shifts), hash);
+                hash = fnv1a(table.scale_places.data(), sizeof(table.scale_places), hash);
+                hash = fnv1a(table.scale_group_sizes.data(), sizeof(table.scale_group_sizes), hash);
+                hash = fnv1a(table.group_places.data(), table.group_places.size() * sizeof(uint32_t), hash);
+                hash = fnv1a(table.group_terms.data(), table.group_terms.size() * sizeof(term_id_t), hash);
+                hash = fnv1a(&table.illion_shift, sizeof(table.illion_shift), hash);
+                hash = fnv1a(&table.illiard_shift, sizeof(table.illiard_shift), hash);
+            }
+
+            return hash;
+        }();
+
+        return stamp;
+    }
+}
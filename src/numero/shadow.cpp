@@ -0,0 +1,142 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+#include "numero/reference.h"
+#include "shadow.h"
+
+namespace num
+{
+    shadow_engine_c::shadow_engine_c(double sample_rate, shadow_mismatch_handler_t mismatch_handler) :
+        _sample_rate(sample_rate),
+        _mismatch_handler(std::move(mismatch_handler))
+    {
+        if (sample_rate < 0.0 || sample_rate > 1.0)
+            throw std::invalid_argument("the shadow sample rate has to be between 0 and 1");
+
+        _worker = std::thread([this]() { process(); });
+    }
+
+    shadow_engine_c::~shadow_engine_c()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+
+        _job_available.notify_all();
+        _worker.join();
+    }
+
+    /*
+     * Decides whether the next conversion is sampled. Sampling is deterministic: of every n conversions exactly
+     * round(n * sample rate) are sampled, evenly spread.
+     */
+    bool shadow_engine_c::sample()
+    {
+        const auto n = _sample_counter.fetch_add(1, std::memory_order_relaxed);
+        return std::floor((n + 1) * _sample_rate) > std::floor(n * _sample_rate);
+    }
+
+    /*
+     * Blocks until all conversions sampled so far have been compared against the reference engine.
+     */
+    void shadow_engine_c::flush()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this]() { return _jobs.empty() && !_busy; });
+    }
+
+    shadow_statistics_t shadow_engine_c::statistics() const
+    {
+        return { _sampled.load(), _compared.load(), _dropped.load(), _mismatches.load() };
+    }
+
+    void shadow_engine_c::submit(std::string_view operation, const std::string_view &input,
+                                 const conversion_options_t &conversion_options, const std::string &result, bool failed)
+    {
+        _sampled++;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_jobs.size() >= max_pending_jobs)
+            {
+                _dropped++;
+                return;
+            }
+
+            // The language is only referenced by the options, so it is copied to outlive the caller's string.
+            auto &job = _jobs.emplace_back(job_t { operation, std::string(input), result, failed, conversion_options,
+                                                   std::string(conversion_options.language) });
+            job.conversion_options.language = job.language;
+        }
+
+        _job_available.notify_one();
+    }
+
+    void shadow_engine_c::process()
+    {
+        reference::converter_c reference_converter;
+
+        for (;;)
+        {
+            job_t job;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _job_available.wait(lock, [this]() { return !_jobs.empty() || _stopping; });
+
+                if (_jobs.empty())
+                    return;
+
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+                _busy = true;
+            }
+
+            job.conversion_options.language = job.language;
+            reference_converter.conversion_options() = job.conversion_options;
+
+            std::string reference_result;
+            bool reference_failed = false;
+
+            try
+            {
+                reference_result = job.operation == "to_number" ? reference_converter.to_number(job.input) :
+                                                                  reference_converter.to_numeral(job.input);
+            }
+            catch (const std::exception &ex)
+            {
+                reference_result = ex.what();
+                reference_failed = true;
+            }
+
+            _compared++;
+
+            // Both engines rejecting an input counts as agreement, even if their error messages differ.
+            const auto agree = job.failed == reference_failed && (job.failed || job.result == reference_result);
+            if (!agree)
+            {
+                _mismatches++;
+
+                const shadow_mismatch_t mismatch { job.operation, job.input, job.result, reference_result,
+                                                   job.failed, reference_failed };
+                if (_mismatch_handler)
+                    _mismatch_handler(mismatch);
+                else
+                    std::cerr << boost::format("Shadow mismatch in %1%(\"%2%\"): \"%3%\" but reference gives \"%4%\"\n")
+                                               % mismatch.operation % mismatch.input % mismatch.result
+                                               % mismatch.reference_result;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _busy = false;
+            }
+
+            _idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef NUMERO_SHADOW_H
+#define NUMERO_SHADOW_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "numero/numero.h"
+#include "german.h"
+
+namespace num
+{
+    /*
+     * Compares a sample of the conversions of a converter against the reference engine. Sampled conversions are queued
+     * and compared by a background thread, so that the converter itself only pays for copying input and result. If the
+     * queue is full, samples are dropped rather than blocking the caller.
+     */
+    class shadow_engine_c
+    {
+    public:
+        shadow_engine_c(double sample_rate, shadow_mismatch_handler_t mismatch_handler);
+        ~shadow_engine_c();
+
+        shadow_engine_c(const shadow_engine_c &) = delete;
+        shadow_engine_c &operator=(const shadow_engine_c &) = delete;
+
+        bool sample();
+        void flush();
+        shadow_statistics_t statistics() const;
+
+        /*
+         * Runs the given conversion and, regardless of whether it succeeds or throws, submits its outcome for being
+         * compared against the reference engine.
+         */
+        template <typename Conversion>
+        std::string run(std::string_view operation, const std::string_view &input,
+                        const conversion_options_t &conversion_options, Conversion &&conversion)
+        {
+            // The reference engine only knows English numerals of the short and long scale.
+            if (is_german(conversion_options) || conversion_options.naming_system == naming_system_t::indian ||
+                conversion_options.naming_system == naming_system_t::myriad)
+                return conversion();
+
+            std::string result;
+
+            try
+            {
+                result = conversion();
+            }
+            catch (const std::out_of_range &)
+            {
+                // The reference engine has no range limits and may take very long on such inputs, so they are not
+                // compared.
+                throw;
+            }
+            catch (const std::exception &ex)
+            {
+                submit(operation, input, conversion_options, ex.what(), true);
+                throw;
+            }
+
+            submit(operation, input, conversion_options, result, false);
+            return result;
+        }
+
+    private:
+        struct job_t
+        {
+            std::string_view operation;
+            std::string input;
+            std::string result;
+            bool failed;
+            conversion_options_t conversion_options;
+            std::string language;
+        };
+
+        void submit(std::string_view operation, const std::string_view &input,
+                    const conversion_options_t &conversion_options, const std::string &result, bool failed);
+        void process();
+
+    private:
+        static constexpr std::size_t max_pending_jobs = 4096;
+
+        const double _sample_rate;
+        const shadow_mismatch_handler_t _mismatch_handler;
+
+        std::atomic<uint64_t> _sample_counter = 0;
+        std::atomic<std::size_t> _sampled = 0;
+        std::atomic<std::size_t> _compared = 0;
+        std::atomic<std::size_t> _dropped = 0;
+        std::atomic<std::size_t> _mismatches = 0;
+
+        std::mutex _mutex;
+        std::condition_variable _job_available;
+        std::condition_variable _idle;
+        std::deque<job_t> _jobs;
+        bool _busy = false;
+        bool _stopping = false;
+        std::thread _worker;
+    };
+};
+
+#endif //NUMERO_SHADOW_H
@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "numero/text_scanner.h"
+#include "german.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace num
+{
+    void append_numeral_terms(bool negative, const std::string_view &integral, const std::string_view &fractional,
+                              const conversion_options_t &conversion_options, std::vector<term_id_t> &terms);
+
+    namespace
+    {
+        /*
+         * Trie of all terms of the lexicon, so that a word is matched against all terms at once in a single pass over
+         * its letters, regardless of their case.
+         */
+        class term_trie_c
+        {
+        public:
+            term_trie_c()
+            {
+                _nodes.emplace_back();
+
+                for (std::size_t term = 0; term < terms_count; term++)
+                {
+                    const auto text = term_text(static_cast<term_id_t>(term));
+                    _max_term_size = std::max(_max_term_size, text.size());
+
+                    std::size_t node = 0;
+                    for (const auto c : text)
+                    {
+                        auto &child = _nodes[node].children[c - 'a'];
+                        if (child == 0)
+                        {
+                            child = static_cast<uint32_t>(_nodes.size());
+                            _nodes.emplace_back();
+                        }
+                        node = _nodes[node].children[c - 'a'];
+                    }
+
+                    _nodes[node].term = static_cast<term_id_t>(term);
+                }
+            }
+
+            std::optional<term_id_t> find(const std::string_view &word) const
+            {
+                std::size_t node = 0;
+                for (const auto c : word)
+                {
+                    const auto letter = c >= 'A' && c <= 'Z' ? c - 'A' : c - 'a';
+                    node = _nodes[node].children[letter];
+                    if (node == 0)
+                        return std::nullopt;
+                }
+
+                return _nodes[node].term;
+            }
+
+            inline std::size_t max_term_size() const {
+                return _max_term_size;
+            }
+
+        private:
+            struct node_t
+            {
+                std::array<uint32_t, 26> children = {};
+                std::optional<term_id_t> term;
+            };
+
+            std::vector<node_t> _nodes;
+            std::size_t _max_term_size = 0;
+        };
+
+        const term_trie_c &get_term_trie()
+        {
+            static const term_trie_c term_trie;
+            return term_trie;
+        }
+
+        inline bool is_letter(const char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        inline bool is_digit(const char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        /*
+         * Finds the first digit or minus sign of a text from the given position on. Where SSE2 is available, sixteen
+         * characters are checked at a time, so that the text between numbers is skipped at close to memory speed.
+         * \returns the position of the character, or the size of the text if there is none.
+         */
+        std::size_t find_number_start(const std::string_view &text, std::size_t position)
+        {
+#if defined(__SSE2__)
+            // Digits are biased into the ten smallest signed bytes, so that a single signed comparison finds them.
+            const auto bias = _mm_set1_epi8(static_cast<char>(0x80 - '0'));
+            const auto limit = _mm_set1_epi8(static_cast<char>(0x80 + 10));
+            const auto minus = _mm_set1_epi8('-');
+
+            for (; position + 16 <= text.size(); position += 16)
+            {
+                const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text.data() + position));
+                const auto digits = _mm_cmplt_epi8(_mm_add_epi8(chars, bias), limit);
+                const auto mask = _mm_movemask_epi8(_mm_or_si128(digits, _mm_cmpeq_epi8(chars, minus)));
+
+                if (mask != 0)
+                    return position + std::countr_zero(static_cast<unsigned>(mask));
+            }
+#endif
+
+            for (; position < text.size(); position++)
+            {
+                if (is_digit(text[position]) || text[position] == '-')
+                    return position;
+            }
+
+            return text.size();
+        }
+    }
+
+    text_scanner_c::text_scanner_c(sink_t sink) :
+        text_scanner_c(conversion_options_t(), std::move(sink))
+    {
+    }
+
+    text_scanner_c::text_scanner_c(const conversion_options_t &conversion_options, sink_t sink) :
+        _conversion_options(conversion_options),
+        _sink(std::move(sink)),
+        _parser(_conversion_options)
+    {
+    }
+
+    /*
+     * Pushes the next chunk of the text. Chunks may split the text anywhere, even within words. Text that can not be
+     * part of a numeral any more is passed to the sink before returning.
+     */
+    void text_scanner_c::push(const std::string_view &chunk)
+    {
+        for (const auto c : chunk)
+            process(c);
+
+        flush();
+    }
+
+    /*
+     * Ends the text and passes the rest of it to the sink.
+     */
+    void text_scanner_c::finish()
+    {
+        if (!_word.empty())
+            end_word();
+
+        resolve_all();
+        flush();
+    }
+
+    void text_scanner_c::process(const char c)
+    {
+        if (is_letter(c))
+        {
+            if (_passing_word)
+            {
+                _output += c;
+            }
+            else if (_word.size() < get_term_trie().max_term_size())
+            {
+                _word += c;
+            }
+            else
+            {
+                // A word longer than any term can not be part of a numeral, so the rest of it is passed through as it
+                // is read rather than collected, which keeps long runs of letters from growing the word unboundedly.
+                const auto word = std::move(_word);
+                _word.clear();
+                resolve_all();
+                _output += word;
+                _output += c;
+                _passing_word = true;
+            }
+            return;
+        }
+
+        _passing_word = false;
+
+        if (!_word.empty())
+            end_word();
+
+        if (_pending_terms.empty())
+        {
+            _output += c;
+            return;
+        }
+
+        // Terms of a numeral are separated by spaces or tabs, or by a single hyphen.
+        const auto separator = std::string_view(_pending_text).substr(_pending_terms.back().end);
+        const auto separates = c == ' ' || c == '\t' ? separator.find('-') == std::string_view::npos :
+                               c == '-' ? separator.empty() : false;
+
+        if (separates)
+        {
+            _pending_text += c;
+            return;
+        }
+
+        resolve();
+        process(c);
+    }
+
+    void text_scanner_c::end_word()
+    {
+        const auto term = get_term_trie().find(_word);
+
+        if (!term)
+        {
+            const auto word = std::move(_word);
+            _word.clear();
+            resolve_all();
+            _output += word;
+            return;
+        }
+
+        // Signs may be repeated at the beginning of a numeral, e.g. "minus minus five", but in text a sign that
+        // follows a sign ends the terms before it, so that incomplete terms never pile up.
+        const auto is_sign = [](const term_id_t term) { return term == term_negative || term == term_minus; };
+        if (is_sign(*term) && _complete_terms_count == 0 && !_pending_terms.empty() &&
+            is_sign(_pending_terms.back().term))
+        {
+            const auto word = std::move(_word);
+            _word.clear();
+            resolve_all();
+            _word = word;
+        }
+
+        _pending_text += _word;
+        _pending_terms.push_back({ *term, _pending_text.size() });
+        _word.clear();
+
+        const auto state = _parser.push(*term);
+
+        if (state == numeral_parser_state_t::complete && (_pending_terms.size() > 1 || *term != term_a))
+        {
+            _complete_terms_count = _pending_terms.size();
+            _complete_value = _parser.partial_value();
+        }
+        else if (state == numeral_parser_state_t::invalid)
+        {
+            resolve();
+        }
+    }
+
+    /*
+     * Replaces the longest numeral at the beginning of the pending text by its number, or leaves the first word as it is
+     * if there is none, and scans the rest of the pending text again. The rest may still be pending afterwards, e.g.
+     * "point" of "one point". Only a sign, "point" or both make a numeral incomplete, so the rest is at most a few
+     * words long.
+     */
+    void text_scanner_c::resolve()
+    {
+        if (_pending_terms.empty())
+        {
+            _output += _pending_text;
+            _pending_text.clear();
+            return;
+        }
+
+        std::size_t end;
+
+        if (_complete_terms_count > 0)
+        {
+            _output += _complete_value;
+            end = _pending_terms[_complete_terms_count - 1].end;
+            _numerals_count++;
+        }
+        else
+        {
+            end = _pending_terms.front().end;
+            _output.append(_pending_text, 0, end);
+        }
+
+        const auto rest = _pending_text.substr(end);
+
+        _pending_text.clear();
+        _pending_terms.clear();
+        _complete_terms_count = 0;
+        _complete_value.clear();
+        _parser.reset();
+
+        for (const auto c : rest)
+            process(c);
+
+        // The last word of the rest has been complete before.
+        if (!_word.empty())
+            end_word();
+    }
+
+    /*
+     * Resolves the pending text until none of it is pending any more, e.g. before a word that can not be part of a
+     * numeral is appended to the output.
+     */
+    void text_scanner_c::resolve_all()
+    {
+        do
+        {
+            resolve();
+        } while (!_pending_terms.empty());
+    }
+
+    void text_scanner_c::flush()
+    {
+        if (!_output.empty())
+        {
+            _sink(_output);
+            _output.clear();
+        }
+    }
+
+    /*
+     * Replaces all numerals in a text by numbers.
+     * \param text The text.
+     * \param conversion_options The conversion options of the numbers.
+     * \returns the text with numbers instead of numerals.
+     */
+    std::string replace_numerals(const std::string_view &text, const conversion_options_t &conversion_options)
+    {
+        std::string result;
+        text_scanner_c text_scanner(conversion_options, [&](const std::string_view &output) { result += output; });
+        text_scanner.push(text);
+        text_scanner.finish();
+        return result;
+    }
+
+    text_verbalizer_c::text_verbalizer_c(sink_t sink) :
+        text_verbalizer_c(conversion_options_t(), std::move(sink))
+    {
+    }
+
+    text_verbalizer_c::text_verbalizer_c(const conversion_options_t &conversion_options, sink_t sink) :
+        _conversion_options(conversion_options),
+        _sink(std::move(sink))
+    {
+    }
+
+    /*
+     * Pushes the next chunk of the text. Chunks may split the text anywhere, even within numbers. Text that can not be
+     * part of a number any more is passed to the sink before returning.
+     */
+    void text_verbalizer_c::push(const std::string_view &chunk)
+    {
+        const auto thousands_separator_symbol = _conversion_options.thousands_separator_symbol;
+        const auto decimal_separator_symbol = _conversion_options.decimal_separator_symbol;
+
+        for (std::size_t position = 0; position < chunk.size();)
+        {
+            if (_token.empty())
+            {
+                const auto start = find_number_start(chunk, position);
+                _output.append(chunk.data() + position, start - position);
+
+                if (start > position)
+                    _previous = chunk[start - 1];
+
+                if (start == chunk.size())
+                    break;
+
+                // A minus sign that follows a letter or a number is a hyphen, e.g. in "5-10".
+                const auto c = chunk[start];
+                position = start + 1;
+
+                if (c == '-' && (is_letter(_previous) || is_digit(_previous)))
+                {
+                    _output += c;
+                    _previous = c;
+                }
+                else
+                {
+                    _token += c;
+                }
+
+                continue;
+            }
+
+            const auto c = chunk[position];
+
+            if (is_digit(c) || (_token != "-" && (c == thousands_separator_symbol || c == decimal_separator_symbol)))
+            {
+                _token += c;
+                position++;
+                continue;
+            }
+
+            end_token(c);
+        }
+
+        flush();
+    }
+
+    /*
+     * Ends the text and passes the rest of it to the sink.
+     */
+    void text_verbalizer_c::finish()
+    {
+        if (!_token.empty())
+            end_token('\0');
+
+        flush();
+    }
+
+    void text_verbalizer_c::end_token(const char next)
+    {
+        const auto is_separator = [&](const char c) {
+            return c == _conversion_options.thousands_separator_symbol ||
+                   c == _conversion_options.decimal_separator_symbol;
+        };
+
+        // Trailing separator symbols belong to the text, e.g. the full stop of "It costs 5."
+        auto end = _token.size();
+        for (; end > 0 && is_separator(_token[end - 1]); end--);
+
+        const auto number = std::string_view(_token).substr(0, end);
+
+        if (is_letter(_previous) || is_letter(next) || !verbalize(number))
+            _output += number;
+
+        _output.append(_token, end);
+        _previous = _token.back();
+        _token.clear();
+    }
+
+    /*
+     * Appends the numeral of a number to the output if the number follows the separator rules of the conversion
+     * options, i.e. the same rules as for the conversion of a number, but without exponents.
+     * \returns false if the number is invalid or too large.
+     */
+    bool text_verbalizer_c::verbalize(const std::string_view &number)
+    {
+        const auto digits_end = [&](std::size_t position) {
+            for (; position < number.size() && is_digit(number[position]); position++);
+            return position;
+        };
+
+        const auto negative = !number.empty() && number.front() == '-';
+        const std::size_t begin = negative ? 1 : 0;
+        auto end = digits_end(begin);
+
+        if (end == begin)
+            return false;
+
+        _integral.assign(number, begin, end - begin);
+        _fractional.clear();
+
+        // Thousands separators are only allowed after a first group of up to three digits and between groups of three.
+        if (end < number.size() && number[end] == _conversion_options.thousands_separator_symbol)
+        {
+            if (end - begin > 3)
+                return false;
+
+            while (end < number.size() && number[end] == _conversion_options.thousands_separator_symbol)
+            {
+                const auto group_end = digits_end(end + 1);
+                if (group_end - end != 4)
+                    return false;
+
+                _integral.append(number, end + 1, 3);
+                end = group_end;
+            }
+        }
+
+        if (end < number.size() && number[end] == _conversion_options.decimal_separator_symbol)
+        {
+            const auto fractional_end = digits_end(end + 1);
+            if (fractional_end == end + 1)
+                return false;
+
+            _fractional.assign(number, end + 1, fractional_end - end - 1);
+            end = fractional_end;
+        }
+
+        if (end != number.size())
+            return false;
+
+        // Leading zeros are not spoken, e.g. "007" is "seven".
+        const auto leading_zeros = std::min(_integral.find_first_not_of('0'), _integral.size() - 1);
+        const auto integral = std::string_view(_integral).substr(leading_zeros);
+
+        try
+        {
+            if (is_german(_conversion_options))
+            {
+                _output += render_german_numeral(negative, integral, _fractional, _conversion_options);
+            }
+            else
+            {
+                _terms.clear();
+                append_numeral_terms(negative, integral, _fractional, _conversion_options, _terms);
+                _output += render_numeral(_terms);
+            }
+        }
+        catch (const std::logic_error &)
+        {
+            return false;
+        }
+
+        _numbers_count++;
+        return true;
+    }
+
+    void text_verbalizer_c::flush()
+    {
+        if (!_output.empty())
+        {
+            _sink(_output);
+            _output.clear();
+        }
+    }
+
+    /*
+     * Replaces all numbers in a text by numerals.
+     * \param text The text.
+     * \param conversion_options The conversion options of the numerals.
+     * \returns the text with numerals instead of numbers.
+     */
+    std::string verbalize_numbers(const std::string_view &text, const conversion_options_t &conversion_options)
+    {
+        std::string result;
+        text_verbalizer_c text_verbalizer(conversion_options, [&](const std::string_view &output) { result += output; });
+        text_verbalizer.push(text);
+        text_verbalizer.finish();
+        return result;
+    }
+}
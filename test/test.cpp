@@ -2,7 +2,81 @@
 #define BOOST_TEST_MODULE numero_test_module
 #include <boost/test/unit_test.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include <numero/aggregate.h>
+#include <numero/corpus.h>
+#include <numero/digit_grouping.h>
+#include <numero/numeral_parser.h>
+#include <numero/numeral_range.h>
 #include <numero/numero.h>
+#include <numero/reference.h>
+#include <numero/result_cache.h>
+#include <numero/text_scanner.h>
+
+/*
+ * Runs conversions through both the converter and the reference engine and checks that both agree on the outcome,
+ * i.e. either on the result or on rejecting the input.
+ */
+struct dual_engine_fixture
+{
+    num::converter_c converter;
+    num::reference::converter_c reference_converter;
+
+    void set_conversion_options(const num::conversion_options_t &conversion_options)
+    {
+        converter.conversion_options() = conversion_options;
+        reference_converter.conversion_options() = conversion_options;
+    }
+
+    void check_to_number(const std::string &numeral)
+    {
+        check_same_outcome(numeral, [&]() { return converter.to_number(numeral); },
+                           [&]() { return reference_converter.to_number(numeral); });
+    }
+
+    void check_to_numeral(const std::string &number)
+    {
+        check_same_outcome(number, [&]() { return converter.to_numeral(number); },
+                           [&]() { return reference_converter.to_numeral(number); });
+    }
+
+    static void check_same_outcome(const std::string &input, const std::function<std::string()> &conversion,
+                                   const std::function<std::string()> &reference_conversion)
+    {
+        const auto outcome = [](const std::function<std::string()> &function) -> std::string {
+            try { return function(); } catch (const std::exception &) { return "<error>"; }
+        };
+
+        BOOST_TEST_CONTEXT("input: \"" << input << "\"")
+            BOOST_CHECK_EQUAL(outcome(conversion), outcome(reference_conversion));
+    }
+};
+
+static const std::vector<std::string> example_numbers = {
+    "0", "3", "12", "-56", "1,001", "1,900", "233,082", "1,002,003,004", "9,999,999,999,999,999", "0.0625", ".75",
+    "3.1415926", "1e3", "1.23e6", "-6.25e-2", "1,00,000", "8million", ""
+};
+
+static const std::vector<std::string> example_numerals = {
+    "zero", "three", "twenty-one", "minus fifty-six", "a hundred", "1 hundred", "nineteen hundred eighteen",
+    "thousand eighty", "one thousand million", "two million million", "twelve million eighty-three thousand fifty-six",
+    "fifteen quindecillion", "one milliard", "point zero six two five", "three point one four one five nine two six",
+    "six thousand fourty-four million", "four million thousand", "zero hundred", "four hundred two ten", "negative",
+    "gazillion", "unbillion", "one unbillion", "two duomillion", "one unmilliard", "one unzillion", "8million", ""
+};
 
 BOOST_AUTO_TEST_CASE(is_number)
 {
@@ -27,6 +101,7 @@ BOOST_AUTO_TEST_CASE(is_number)
     BOOST_CHECK(english_converter.is_number("0.333.333") == false);
     BOOST_CHECK(english_converter.is_number("0.333 333") == false);
     BOOST_CHECK(english_converter.is_number("-6.25e-2"));
+    BOOST_CHECK(english_converter.is_number("1e99999999999"));
 
     num::conversion_options_t german_options;
     german_options.thousands_separator_symbol = '.';
@@ -52,6 +127,8 @@ BOOST_AUTO_TEST_CASE(convert_invalid_arguments)
     BOOST_CHECK_THROW(converter.to_number("8million"), std::invalid_argument);
     BOOST_CHECK_THROW(converter.to_number("negative"), std::invalid_argument);
     BOOST_CHECK_THROW(converter.to_number("gazillion"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_numeral("1e99999999999"), std::out_of_range);
+    BOOST_CHECK_THROW(converter.to_numeral("1e-999999999"), std::out_of_range);
 }
 
 BOOST_AUTO_TEST_CASE(convert_fundamentals)
@@ -209,3 +286,802 @@ BOOST_AUTO_TEST_CASE(convert_logic_errors)
     BOOST_CHECK_THROW(converter.to_number("four hundred two ten"), std::logic_error);
     BOOST_CHECK_THROW(converter.to_number("four hundred three sixty"), std::logic_error);
 }
+
+BOOST_FIXTURE_TEST_CASE(dual_engine_examples, dual_engine_fixture)
+{
+    for (const auto &number : example_numbers)
+        check_to_numeral(number);
+
+    for (const auto &numeral : example_numerals)
+        check_to_number(numeral);
+
+    num::conversion_options_t long_scale_options;
+    long_scale_options.naming_system = num::naming_system_t::long_scale;
+    set_conversion_options(long_scale_options);
+
+    for (const auto &number : example_numbers)
+        check_to_numeral(number);
+
+    for (const auto &numeral : example_numerals)
+        check_to_number(numeral);
+}
+
+BOOST_AUTO_TEST_CASE(shadow_mode)
+{
+    num::converter_c converter;
+    std::vector<num::shadow_mismatch_t> mismatches;
+
+    converter.enable_shadow_mode(0.5, [&](const num::shadow_mismatch_t &mismatch) { mismatches.push_back(mismatch); });
+
+    for (const auto &number : example_numbers)
+        try { converter.to_numeral(number); } catch (const std::exception &) {}
+
+    for (const auto &numeral : example_numerals)
+        try { converter.to_number(numeral); } catch (const std::exception &) {}
+
+    converter.flush_shadow_mode();
+
+    const auto statistics = converter.shadow_statistics();
+    BOOST_CHECK_EQUAL(statistics.sampled, (example_numbers.size() + example_numerals.size()) / 2);
+    BOOST_CHECK_EQUAL(statistics.compared, statistics.sampled);
+    BOOST_CHECK_EQUAL(statistics.mismatches, 0);
+    BOOST_CHECK(mismatches.empty());
+
+    BOOST_CHECK_THROW(converter.enable_shadow_mode(1.5), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(corpus_round_trip)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "numero_test_corpus.bin").string();
+    const std::vector<std::string> inputs = { "1,234.5", "", "one hundred twenty-three", "7e21" };
+
+    {
+        num::corpus_writer_c corpus_writer(path, "--seed 1");
+        for (const auto &input : inputs)
+            corpus_writer.append(input);
+    }
+
+    BOOST_CHECK(num::corpus_c::is_corpus(path));
+
+    {
+        num::corpus_c corpus(path, true);
+        BOOST_CHECK_EQUAL(corpus.options(), "--seed 1");
+        BOOST_REQUIRE_EQUAL(corpus.size(), inputs.size());
+        BOOST_CHECK_EQUAL_COLLECTIONS(corpus.begin(), corpus.end(), inputs.begin(), inputs.end());
+        BOOST_CHECK_EQUAL(corpus[2], "one hundred twenty-three");
+    }
+
+    {
+        // Corrupt the last offset, which is only detected when the input is accessed without verification.
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        num::corpus_header_t header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        const uint64_t offset = header.blob_size + 1;
+        file.seekp(header.offsets_offset + header.count * sizeof(uint64_t));
+        file.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+    }
+
+    {
+        num::corpus_c corpus(path);
+        BOOST_CHECK_EQUAL(corpus[0], "1,234.5");
+        BOOST_CHECK_THROW(corpus[inputs.size() - 1], std::runtime_error);
+    }
+
+    BOOST_CHECK_THROW(num::corpus_c corpus(path, true), std::runtime_error);
+
+    {
+        // Corrupt the blob offset, so that the sum of the blob offset and size wraps around.
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        const uint64_t blob_offset = std::numeric_limits<uint64_t>::max() - 7;
+        file.seekp(offsetof(num::corpus_header_t, blob_offset));
+        file.write(reinterpret_cast<const char *>(&blob_offset), sizeof(blob_offset));
+    }
+
+    BOOST_CHECK_THROW(num::corpus_c corpus(path), std::runtime_error);
+
+    std::remove(path.c_str());
+    BOOST_CHECK_THROW(num::corpus_c corpus(path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(numeral_column)
+{
+    const std::vector<uint64_t> values = { 0, 1, 7, 13, 21, 40, 100, 101, 999, 1000, 1001, 20020, 1000000, 1002003,
+                                           9999999999, 1234567890123456789, std::numeric_limits<uint64_t>::max() };
+
+    for (const auto naming_system : { num::naming_system_t::short_scale, num::naming_system_t::long_scale,
+                                      num::naming_system_t::indian, num::naming_system_t::myriad })
+    {
+        num::conversion_options_t conversion_options;
+        conversion_options.naming_system = naming_system;
+        num::converter_c converter(conversion_options);
+
+        const auto column = converter.to_numeral_column(values);
+        BOOST_REQUIRE_EQUAL(column.size(), values.size());
+        BOOST_CHECK_EQUAL(column.offsets.back(), column.data.size());
+
+        for (std::size_t i = 0; i < values.size(); i++)
+            BOOST_CHECK_EQUAL(column[i], converter.to_numeral(std::to_string(values[i])));
+    }
+
+    num::converter_c converter;
+    const std::vector<uint32_t> small_values = { 0, 42, 4294967295 };
+    const auto column = converter.to_numeral_column(small_values);
+    BOOST_REQUIRE_EQUAL(column.size(), small_values.size());
+    BOOST_CHECK_EQUAL(column[0], "zero");
+    BOOST_CHECK_EQUAL(column[1], "fourty-two");
+    BOOST_CHECK_EQUAL(column[2], "four billion two hundred ninety-four million nine hundred sixty-seven thousand two "
+                                 "hundred ninety-five");
+
+    BOOST_CHECK_EQUAL(converter.to_numeral_column(std::vector<uint64_t>()).size(), 0);
+
+    // Columns of several blocks of rows.
+    std::vector<uint64_t> many_values(2500);
+    for (std::size_t i = 0; i < many_values.size(); i++)
+        many_values[i] = i * i * 7919;
+
+    const auto many_column = converter.to_numeral_column(many_values);
+    BOOST_REQUIRE_EQUAL(many_column.size(), many_values.size());
+    BOOST_CHECK_EQUAL(many_column.offsets.back(), many_column.data.size());
+
+    for (std::size_t i = 0; i < many_values.size(); i += 97)
+        BOOST_CHECK_EQUAL(many_column[i], converter.to_numeral(std::to_string(many_values[i])));
+}
+
+BOOST_AUTO_TEST_CASE(convert_indian_and_myriad)
+{
+    num::conversion_options_t indian_options;
+    indian_options.naming_system = num::naming_system_t::indian;
+    num::converter_c indian_converter(indian_options);
+
+    num::conversion_options_t myriad_options;
+    myriad_options.naming_system = num::naming_system_t::myriad;
+    num::converter_c myriad_converter(myriad_options);
+
+    const std::vector<std::tuple<std::string, std::string, std::string>> numbers_and_numerals = {
+        { "1,000", "one thousand", "ten hundred" },
+        { "100,000", "one lakh", "ten myriad" },
+        { "123,456,789", "twelve crore thirty-four lakh fifty-six thousand seven hundred eighty-nine",
+          "one oku twenty-three hundred fourty-five myriad sixty-seven hundred eighty-nine" },
+        { "-20,000,000.5", "negative two crore point five", "negative twenty hundred myriad point five" },
+        { "1,000,000,000,000", "ten kharab", "one cho" }
+    };
+
+    for (const auto &[number, indian_numeral, myriad_numeral] : numbers_and_numerals)
+    {
+        BOOST_CHECK_EQUAL(indian_converter.to_numeral(number), indian_numeral);
+        BOOST_CHECK(indian_converter.is_canonical_numeral(indian_numeral));
+        BOOST_CHECK_EQUAL(indian_converter.to_number(indian_numeral), number);
+        BOOST_CHECK_EQUAL(myriad_converter.to_numeral(number), myriad_numeral);
+        BOOST_CHECK_EQUAL(myriad_converter.to_number(myriad_numeral), number);
+        BOOST_CHECK(myriad_converter.is_canonical_numeral(myriad_numeral));
+    }
+
+    // Scale words only apply in their own naming system, and groups are no larger than the naming system has them.
+    BOOST_CHECK(!indian_converter.is_canonical_numeral("one hundred thousand"));
+    BOOST_CHECK_EQUAL(indian_converter.canonicalize_numeral("one hundred thousand"), "one lakh");
+    BOOST_CHECK(!myriad_converter.is_canonical_numeral("one thousand two hundred"));
+    BOOST_CHECK(!num::converter_c().is_canonical_numeral("twelve hundred"));
+    BOOST_CHECK_THROW(num::converter_c().to_number("one lakh"), std::invalid_argument);
+    BOOST_CHECK_THROW(indian_converter.to_number("one million"), std::invalid_argument);
+    BOOST_CHECK_THROW(myriad_converter.to_numeral("1" + std::string(24, '0')), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(digit_grouping)
+{
+    using num::digit_grouping_t;
+
+    const std::vector<std::tuple<std::string, digit_grouping_t, std::string>> digits_and_groups = {
+        { "", digit_grouping_t::thousands, "" },
+        { "123", digit_grouping_t::thousands, "123" },
+        { "1234", digit_grouping_t::thousands, "1,234" },
+        { "1234567", digit_grouping_t::thousands, "1,234,567" },
+        { "123456", digit_grouping_t::indian, "1,23,456" },
+        { "123456789", digit_grouping_t::indian, "12,34,56,789" },
+        { "1234", digit_grouping_t::myriad, "1234" },
+        { "123456789", digit_grouping_t::myriad, "1,2345,6789" }
+    };
+
+    for (const auto &[digits, grouping, grouped] : digits_and_groups)
+    {
+        BOOST_CHECK_EQUAL(num::group_digits(digits, ",", grouping), grouped);
+        BOOST_CHECK_EQUAL(num::grouped_digits_size(digits.size(), 1, grouping), grouped.size());
+
+        std::string in_place = digits;
+        num::group_digits_in_place(in_place, ",", grouping);
+        BOOST_CHECK_EQUAL(in_place, grouped);
+    }
+
+    // Separators of more than one byte, and appending to what is already there
+    BOOST_CHECK_EQUAL(num::group_digits("1234567", "\u202f"), "1\u202f234\u202f567");
+    std::string target = "-";
+    num::append_grouped_digits("12345678", "\u202f", digit_grouping_t::indian, target);
+    BOOST_CHECK_EQUAL(target, "-1\u202f23\u202f45\u202f678");
+}
+
+BOOST_AUTO_TEST_CASE(numeral_terms)
+{
+    num::converter_c converter;
+
+    const auto terms = converter.to_numeral_terms("-21,000,105.5");
+    const std::vector<num::term_id_t> expected_terms = {
+        num::term_negative, num::tens_term(2), num::unit_term(1), num::illion_term(1), num::unit_term(1),
+        num::term_hundred, num::unit_term(5), num::term_point, num::unit_term(5)
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(terms.begin(), terms.end(), expected_terms.begin(), expected_terms.end());
+    BOOST_CHECK_EQUAL(num::render_numeral(terms), "negative twenty-one million one hundred five point five");
+
+    for (const auto &number : example_numbers)
+    {
+        BOOST_TEST_CONTEXT(number)
+        {
+            std::string numeral;
+            try { numeral = converter.to_numeral(number); } catch (const std::exception &) { continue; }
+            BOOST_CHECK_EQUAL(num::render_numeral(converter.to_numeral_terms(number)), numeral);
+        }
+    }
+
+    converter.conversion_options().naming_system = num::naming_system_t::long_scale;
+    BOOST_CHECK_EQUAL(num::render_numeral(converter.to_numeral_terms("1000000000")), "one milliard");
+    BOOST_CHECK(converter.to_numeral_terms("1000000000").back() == num::illiard_term(1));
+
+    BOOST_CHECK_EQUAL(num::term_text(num::term_thousand), "thousand");
+    BOOST_CHECK_EQUAL(num::term_text(num::illion_term(23)), "trevigintillion");
+    BOOST_CHECK_EQUAL(num::term_text(num::illiard_term(100)), "centilliard");
+    BOOST_CHECK_THROW(num::term_text(static_cast<num::term_id_t>(num::terms_count)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(numeral_terms_to_number)
+{
+    num::converter_c converter;
+
+    BOOST_CHECK(num::find_term_id("twenty") == num::tens_term(2));
+    BOOST_CHECK(num::find_term_id("quindecillion") == num::illion_term(15));
+    BOOST_CHECK(!num::find_term_id("gazillion").has_value());
+
+    // Term identifiers convert like the text they render to, with valid and invalid numerals alike.
+    for (const auto &numeral : example_numerals)
+    {
+        std::vector<num::term_id_t> terms;
+        std::string term;
+        std::istringstream terms_stream(boost::replace_all_copy(numeral, "-", " "));
+        bool all_terms_known = true;
+
+        while (terms_stream >> term)
+        {
+            const auto term_id = num::find_term_id(term);
+            all_terms_known &= term_id.has_value();
+            if (term_id)
+                terms.push_back(*term_id);
+        }
+
+        // A lone sign is rejected by the numeral pattern of text before it is parsed.
+        if (!all_terms_known || terms.empty() || (terms.size() == 1 && terms[0] == num::term_negative))
+            continue;
+
+        const auto outcome = [](auto &&conversion) {
+            try { return conversion(); } catch (const std::exception &ex) { return std::string(ex.what()); }
+        };
+
+        BOOST_TEST_CONTEXT(numeral)
+        {
+            BOOST_CHECK_EQUAL(outcome([&]() { return converter.to_number(terms); }),
+                              outcome([&]() { return converter.to_number(numeral); }));
+        }
+    }
+
+    const std::vector<num::term_id_t> invalid_terms = { num::unit_term(1), num::term_a };
+    BOOST_CHECK_THROW(converter.to_number(invalid_terms), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number(std::vector<num::term_id_t>()), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number(std::vector<num::term_id_t>{ 255 }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(numeral_parser)
+{
+    num::numeral_parser_c parser;
+
+    BOOST_CHECK(parser.push("negative") == num::numeral_parser_state_t::incomplete);
+    BOOST_CHECK_EQUAL(parser.partial_value(), "");
+    BOOST_CHECK(parser.push("two") == num::numeral_parser_state_t::complete);
+    BOOST_CHECK(parser.push("thousand") == num::numeral_parser_state_t::complete);
+    BOOST_CHECK_EQUAL(parser.partial_value(), "-2,000");
+    BOOST_CHECK(parser.push("fourty-five") == num::numeral_parser_state_t::complete);
+    BOOST_CHECK_EQUAL(parser.partial_value(), "-2,045");
+    BOOST_CHECK(parser.push("point") == num::numeral_parser_state_t::incomplete);
+    BOOST_CHECK_EQUAL(parser.partial_value(), "-2,045");
+    BOOST_CHECK_THROW(parser.finish(), std::invalid_argument);
+    BOOST_CHECK(parser.push(num::unit_term(5)) == num::numeral_parser_state_t::complete);
+    BOOST_CHECK_EQUAL(parser.finish(), "-2,045.5");
+
+    // Sub numerals must not overlap the places of those before them.
+    parser.reset();
+    BOOST_CHECK(parser.push("one million fifteen hundred") == num::numeral_parser_state_t::complete);
+    BOOST_CHECK_EQUAL(parser.partial_value(), "1,001,500");
+    BOOST_CHECK(parser.push("thousand") == num::numeral_parser_state_t::invalid);
+
+    // A higher magnitude sub numeral can not follow a lower one, no matter which terms follow.
+    parser.reset();
+    BOOST_CHECK(parser.push("two") == num::numeral_parser_state_t::complete);
+    BOOST_CHECK(parser.push("thousand") == num::numeral_parser_state_t::complete);
+    BOOST_CHECK(parser.push("five") == num::numeral_parser_state_t::complete);
+    BOOST_CHECK(parser.push("million") == num::numeral_parser_state_t::invalid);
+    BOOST_CHECK(parser.push("one") == num::numeral_parser_state_t::invalid);
+    BOOST_CHECK(!parser.error().empty());
+    BOOST_CHECK_EQUAL(parser.partial_value(), "");
+    BOOST_CHECK_THROW(parser.finish(), std::invalid_argument);
+
+    // Finishing gives the same number as converting the terms at once.
+    num::converter_c converter;
+    for (const auto &numeral : example_numerals)
+    {
+        parser.reset();
+        std::string term;
+        std::istringstream terms_stream(numeral);
+        while (terms_stream >> term)
+            parser.push(term);
+
+        const auto outcome = [](auto &&conversion) {
+            try { return conversion(); } catch (const std::exception &ex) { return std::string(ex.what()); }
+        };
+
+        if (parser.state() == num::numeral_parser_state_t::complete)
+            BOOST_CHECK_EQUAL(parser.finish(), converter.to_number(numeral));
+        else if (parser.state() == num::numeral_parser_state_t::invalid)
+            BOOST_CHECK_EQUAL(parser.error(), outcome([&]() { return converter.to_number(numeral); }));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(numeral_range)
+{
+    for (const auto naming_system : { num::naming_system_t::short_scale, num::naming_system_t::long_scale,
+                                      num::naming_system_t::indian, num::naming_system_t::myriad })
+    {
+        num::conversion_options_t conversion_options;
+        conversion_options.naming_system = naming_system;
+        num::converter_c converter(conversion_options);
+
+        // Steps across group and scale boundaries render the same numerals as to_numeral.
+        for (const auto &[first, last] : { std::pair<uint64_t, uint64_t>(0, 2100),
+                                           std::pair<uint64_t, uint64_t>(999990, 1000010),
+                                           std::pair<uint64_t, uint64_t>(999999999999999990, 1000000000000000010) })
+        {
+            uint64_t value = first;
+            for (auto it = num::numeral_range_c(first, last, conversion_options).begin(),
+                 end = num::numeral_range_c(first, last, conversion_options).end(); it != end; ++it, ++value)
+            {
+                BOOST_REQUIRE_EQUAL(it.value(), value);
+                BOOST_REQUIRE_EQUAL(*it, converter.to_numeral(std::to_string(value)));
+            }
+            BOOST_CHECK_EQUAL(value, last + 1);
+        }
+    }
+
+    const auto max = std::numeric_limits<uint64_t>::max();
+    const num::numeral_range_c range(max - 2, max);
+    BOOST_CHECK_EQUAL(std::distance(range.begin(), range.end()), 3);
+
+    // Subranges cover the range without gaps.
+    const auto subranges = num::numeral_range_c(10, 20).partition(4);
+    BOOST_REQUIRE_EQUAL(subranges.size(), 4);
+    BOOST_CHECK_EQUAL(subranges[0].first(), 10);
+    BOOST_CHECK_EQUAL(subranges[0].last(), 12);
+    BOOST_CHECK_EQUAL(subranges[3].first(), 19);
+    BOOST_CHECK_EQUAL(subranges[3].last(), 20);
+    BOOST_CHECK_EQUAL(*subranges[1].begin(), "thirteen");
+    BOOST_CHECK_EQUAL(num::numeral_range_c(5, 6).partition(8).size(), 2);
+    BOOST_CHECK_THROW(num::numeral_range_c(6, 5), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(compare_values)
+{
+    num::converter_c converter;
+
+    // Inputs ranked by their values, numbers and numerals mixed.
+    const std::vector<std::pair<int, std::string>> ranked = {
+        { 0, "minus two million" }, { 1, "-1,999,999" }, { 2, "negative nineteen hundred eighteen" },
+        { 3, "-1.5e3" }, { 4, "negative three" }, { 5, "-0.0625" }, { 6, "zero" }, { 6, "0" },
+        { 7, "point zero six two five" }, { 7, "0.0625e0" }, { 8, "point five" }, { 9, "0.51" }, { 10, "a hundred" },
+        { 11, "100.5" }, { 12, "nineteen hundred eighteen" }, { 13, "one thousand million" }, { 14, "1,000,000,001" },
+        { 15, "fifteen quindecillion" }
+    };
+
+    for (const auto &[a_rank, a] : ranked)
+    {
+        for (const auto &[b_rank, b] : ranked)
+        {
+            BOOST_TEST_CONTEXT(a << " <=> " << b)
+            {
+                const auto order = converter.compare_values(a, b);
+                const auto key_order = converter.sort_key(a) <=> converter.sort_key(b);
+                const auto digits_order = converter.compare_values(a, converter.significant_digits(b));
+
+                BOOST_CHECK_EQUAL(order < 0, a_rank < b_rank);
+                BOOST_CHECK_EQUAL(order > 0, a_rank > b_rank);
+                BOOST_CHECK_EQUAL(key_order < 0, a_rank < b_rank);
+                BOOST_CHECK_EQUAL(key_order > 0, a_rank > b_rank);
+                BOOST_CHECK_EQUAL(digits_order < 0, a_rank < b_rank);
+                BOOST_CHECK_EQUAL(digits_order > 0, a_rank > b_rank);
+            }
+        }
+    }
+
+    BOOST_CHECK_EQUAL(converter.compare_values("point zero six two five", "0.0625"), 0);
+    BOOST_CHECK_EQUAL(converter.compare_values("1e3", "one thousand"), 0);
+    BOOST_CHECK(converter.sort_key("-0") == converter.sort_key("zero"));
+
+    BOOST_CHECK_EQUAL(converter.estimate_magnitude("twelve million eighty-three thousand fifty-six").exponent, 8);
+    BOOST_CHECK_EQUAL(converter.estimate_magnitude("negative point zero zero five").sign, -1);
+    BOOST_CHECK_EQUAL(converter.estimate_magnitude("negative point zero zero five").exponent, -2);
+    BOOST_CHECK_EQUAL(converter.estimate_magnitude("3.85e9").exponent, 10);
+    BOOST_CHECK_THROW(converter.compare_values("gazillion", "one"), std::invalid_argument);
+
+    // Exponents out of the supported range are rejected as by to_numeral rather than clamped to it.
+    BOOST_CHECK_EQUAL(converter.estimate_magnitude("1e4096").exponent, 4097);
+    BOOST_CHECK_THROW(converter.compare_values("1e5000", "1e4097"), std::out_of_range);
+    BOOST_CHECK_THROW(converter.sort_key("1e5000"), std::out_of_range);
+    BOOST_CHECK_THROW(converter.estimate_magnitude("-1e-5000"), std::out_of_range);
+    BOOST_CHECK_THROW(converter.significant_digits("1e99999999999"), std::out_of_range);
+
+    // Inputs are filtered against the significant digits of the bounds of a range, so neither may be out of range.
+    const auto low = converter.significant_digits("1e4000");
+    BOOST_CHECK_GT(converter.compare_values("1e4096", low), 0);
+    BOOST_CHECK_THROW(converter.compare_values("1e5000", low), std::out_of_range);
+    BOOST_CHECK_THROW(converter.compare_values("-1e5000", low), std::out_of_range);
+
+    // The significant digits of numerals are the same as those of the numbers they convert to.
+    for (const auto naming_system : { num::naming_system_t::short_scale, num::naming_system_t::long_scale })
+    {
+        converter.conversion_options().naming_system = naming_system;
+
+        for (const auto &numeral : example_numerals)
+        {
+            BOOST_TEST_CONTEXT("numeral: \"" << numeral << "\"")
+            {
+                std::string number;
+                try { number = converter.to_number(numeral); } catch (const std::exception &) {}
+
+                if (number.empty())
+                {
+                    BOOST_CHECK_THROW(converter.significant_digits(numeral), std::exception);
+                    continue;
+                }
+
+                const auto digits = converter.significant_digits(numeral);
+                const auto number_digits = converter.significant_digits(number);
+                BOOST_CHECK_EQUAL(digits.negative, number_digits.negative);
+                BOOST_CHECK_EQUAL(digits.exponent, number_digits.exponent);
+                BOOST_CHECK_EQUAL(digits.digits, number_digits.digits);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(value_hash)
+{
+    num::converter_c converter;
+
+    const auto billion_hash = converter.value_hash("one billion");
+    BOOST_CHECK_EQUAL(converter.value_hash("one thousand million"), billion_hash);
+    BOOST_CHECK_EQUAL(converter.value_hash("1,000,000,000"), billion_hash);
+    BOOST_CHECK_EQUAL(converter.value_hash("1000000000.00"), billion_hash);
+    BOOST_CHECK_EQUAL(converter.value_hash("1e9"), billion_hash);
+    BOOST_CHECK_NE(converter.value_hash("1e10"), billion_hash);
+    BOOST_CHECK_NE(converter.value_hash("-1e9"), billion_hash);
+    BOOST_CHECK_NE(converter.value_hash("1,000,000,001"), billion_hash);
+
+    BOOST_CHECK_EQUAL(converter.value_hash("point zero six two five"), converter.value_hash("6.25e-2"));
+    BOOST_CHECK_EQUAL(converter.value_hash("zero"), converter.value_hash("-0.0"));
+    BOOST_CHECK_NE(converter.value_hash("twelve million eighty-three thousand fifty-six"),
+                   converter.value_hash("twelve million eighty-three thousand fifty-seven"));
+    BOOST_CHECK_THROW(converter.value_hash("gazillion"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.value_hash("one million fifteen hundred thousand"), std::logic_error);
+    BOOST_CHECK_THROW(converter.value_hash("three point"), std::invalid_argument);
+    BOOST_CHECK_NE(converter.value_hash("1e4096"), converter.value_hash("1e4095"));
+    BOOST_CHECK_THROW(converter.value_hash("1e5000"), std::out_of_range);
+    BOOST_CHECK_THROW(converter.value_hash("1e-9999"), std::out_of_range);
+    BOOST_CHECK_EQUAL(converter.value_hash("1 hundred five point two"), converter.value_hash("105.2"));
+    BOOST_CHECK_EQUAL(converter.value_hash("nineteen hundred\teighteen"), converter.value_hash("1918"));
+
+    converter.conversion_options().naming_system = num::naming_system_t::long_scale;
+    BOOST_CHECK_EQUAL(converter.value_hash("one milliard"), billion_hash);
+}
+
+BOOST_AUTO_TEST_CASE(canonicalize_numeral)
+{
+    num::converter_c converter;
+
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("thousand eighty"), "one thousand eighty");
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("nineteen hundred eighteen"), "one thousand nine hundred eighteen");
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("two million million"), "two trillion");
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("minus 5 hundred twenty one point 2"),
+                      "negative five hundred twenty-one point two");
+    BOOST_CHECK_THROW(converter.canonicalize_numeral("four hundred two ten"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.canonicalize_numeral(""), std::invalid_argument);
+
+    // Canonical numerals are returned unchanged. Numbers without integral part are rendered without leading zero,
+    // which their numerals are converted back with.
+    for (const auto &number : example_numbers)
+    {
+        if (!converter.is_number(number) || number.front() == '.')
+            continue;
+
+        const auto numeral = converter.to_numeral(number);
+        BOOST_TEST_CONTEXT(numeral)
+        {
+            BOOST_CHECK(converter.is_canonical_numeral(numeral));
+            BOOST_CHECK_EQUAL(converter.canonicalize_numeral(numeral), numeral);
+        }
+    }
+
+    for (const auto &numeral : example_numerals)
+    {
+        BOOST_TEST_CONTEXT(numeral)
+        {
+            const auto outcome = [](auto &&conversion) {
+                try { return conversion(); } catch (const std::exception &ex) { return std::string(ex.what()); }
+            };
+
+            const auto expected = outcome([&]() { return converter.to_numeral(converter.to_number(numeral)); });
+            BOOST_CHECK_EQUAL(outcome([&]() { return converter.canonicalize_numeral(numeral); }), expected);
+            BOOST_CHECK_EQUAL(converter.is_canonical_numeral(numeral), expected == numeral);
+        }
+    }
+
+    BOOST_CHECK(!converter.is_canonical_numeral("twenty one"));
+    BOOST_CHECK(!converter.is_canonical_numeral("one thousand million"));
+    BOOST_CHECK(!converter.is_canonical_numeral("point five"));
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("point five"), "zero point five");
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("negative zero point five"), "negative zero point five");
+
+    converter.conversion_options().force_leading_zero = false;
+    BOOST_CHECK(converter.is_canonical_numeral("point five"));
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("zero point five"), "point five");
+}
+
+BOOST_AUTO_TEST_CASE(fuzzy_terms)
+{
+    num::converter_c converter;
+
+    BOOST_CHECK_THROW(converter.to_number("thre hundered milion"), std::invalid_argument);
+
+    converter.conversion_options().max_term_edits = 2;
+
+    std::vector<num::term_correction_t> corrections;
+    BOOST_CHECK_EQUAL(converter.to_number("thre hundered milion forty-two", corrections), "300,000,042");
+    BOOST_REQUIRE_EQUAL(corrections.size(), 4);
+    BOOST_CHECK_EQUAL(corrections[0].term, "thre");
+    BOOST_CHECK_EQUAL(corrections[0].correction, "three");
+    BOOST_CHECK_EQUAL(corrections[0].edits, 1);
+    BOOST_CHECK_EQUAL(corrections[0].position, 0);
+    BOOST_CHECK_EQUAL(corrections[3].term, "forty");
+    BOOST_CHECK_EQUAL(corrections[3].correction, "fourty");
+    BOOST_CHECK_EQUAL(corrections[3].position, 21);
+    BOOST_CHECK_EQUAL(converter.to_number("seventeen"), "17");
+    BOOST_CHECK_EQUAL(converter.convert("one thousnad"), "1,000");
+
+    // Terms that are ambiguous, too short or too far from any term are not corrected.
+    BOOST_CHECK_THROW(converter.to_number("sixy"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number("tw"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number("gazillion"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(text_scanner)
+{
+    BOOST_CHECK_EQUAL(num::replace_numerals("revenue rose by two hundred thirty million dollars"),
+                      "revenue rose by 230,000,000 dollars");
+    BOOST_CHECK_EQUAL(num::replace_numerals("Twenty-one guns, a dog and nine-tenths"), "21 guns, a dog and 9-tenths");
+    BOOST_CHECK_EQUAL(num::replace_numerals("the point is: minus three point five, not 3.5"),
+                      "the point is: -3.5, not 3.5");
+    BOOST_CHECK_EQUAL(num::replace_numerals("five six hundred\nseven"), "5 600\n7");
+    BOOST_CHECK_EQUAL(num::replace_numerals("a hundred and one"), "100 and 1");
+    BOOST_CHECK_EQUAL(num::replace_numerals("minus"), "minus");
+
+    // Terms that stay pending after a numeral keep their place in the text.
+    BOOST_CHECK_EQUAL(num::replace_numerals("at one point the end"), "at 1 point the end");
+    BOOST_CHECK_EQUAL(num::replace_numerals("one point"), "1 point");
+    BOOST_CHECK_EQUAL(num::replace_numerals("minus minus the"), "minus minus the");
+    BOOST_CHECK_EQUAL(num::replace_numerals("minus minus five"), "minus -5");
+
+    // Words longer than any term are passed through as they are read.
+    const auto long_word = "twenty" + std::string(10000, 'x');
+    BOOST_CHECK_EQUAL(num::replace_numerals("five " + long_word + " six"), "5 " + long_word + " 6");
+    BOOST_CHECK_EQUAL(num::replace_numerals("minus " + long_word), "minus " + long_word);
+
+    // Chunks may split the text anywhere.
+    const std::string text = "In nineteen hundred eighteen, about fifty-five thousand point two were counted.";
+    std::string result;
+    num::text_scanner_c text_scanner([&](const std::string_view &output) { result += output; });
+    for (const auto c : text)
+        text_scanner.push(std::string_view(&c, 1));
+    text_scanner.finish();
+
+    BOOST_CHECK_EQUAL(result, "In 1,918, about 55,000.2 were counted.");
+    BOOST_CHECK_EQUAL(result, num::replace_numerals(text));
+    BOOST_CHECK_EQUAL(text_scanner.numerals_count(), 2);
+
+    result.clear();
+    num::text_scanner_c long_word_scanner([&](const std::string_view &output) { result += output; });
+    long_word_scanner.push("one ");
+    for (std::size_t i = 0; i < long_word.size(); i += 7)
+        long_word_scanner.push(std::string_view(long_word).substr(i, 7));
+    long_word_scanner.push(" two");
+    long_word_scanner.finish();
+    BOOST_CHECK_EQUAL(result, "1 " + long_word + " 2");
+}
+
+BOOST_AUTO_TEST_CASE(text_verbalizer)
+{
+    BOOST_CHECK_EQUAL(num::verbalize_numbers("Pay 1,250.50 by 3 pm."),
+                      "Pay one thousand two hundred fifty point five zero by three pm.");
+    BOOST_CHECK_EQUAL(num::verbalize_numbers("3rd place, A4 paper, 5-10 items, -7 degrees"),
+                      "3rd place, A4 paper, five-ten items, negative seven degrees");
+    BOOST_CHECK_EQUAL(num::verbalize_numbers("1,25 or 1.2.3, but 12,345,678 and 007"),
+                      "1,25 or 1.2.3, but twelve million three hundred fourty-five thousand six hundred seventy-eight "
+                      "and seven");
+
+    num::conversion_options_t conversion_options;
+    conversion_options.thousands_separator_symbol = '.';
+    conversion_options.decimal_separator_symbol = ',';
+    BOOST_CHECK_EQUAL(num::verbalize_numbers("Zahlen Sie 1.250,5 bis 3 Uhr.", conversion_options),
+                      "Zahlen Sie one thousand two hundred fifty point five bis three Uhr.");
+
+    // Chunks may split the text anywhere.
+    const std::string text = "Between 1914 and 1,918.25 about -55 out of 20,000,000, or 0.5 percent, were 1st.";
+    std::string result;
+    num::text_verbalizer_c text_verbalizer([&](const std::string_view &output) { result += output; });
+    for (const auto c : text)
+        text_verbalizer.push(std::string_view(&c, 1));
+    text_verbalizer.finish();
+
+    BOOST_CHECK_EQUAL(result, "Between one thousand nine hundred fourteen and one thousand nine hundred eighteen point "
+                              "two five about negative fifty-five out of twenty million, or zero point five percent, "
+                              "were 1st.");
+    BOOST_CHECK_EQUAL(result, num::verbalize_numbers(text));
+    BOOST_CHECK_EQUAL(text_verbalizer.numbers_count(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(value_aggregate)
+{
+    num::converter_c converter;
+    num::value_aggregate_c aggregate, other_aggregate;
+
+    for (const auto &input : { "one thousand two hundred fifty point five", "1,250.50", "-3.125", "zero", "0.0625" })
+        converter.accumulate(input, aggregate);
+
+    for (const auto &input : { "minus twelve million", "1e3", "nineteen hundred eighteen" })
+        converter.accumulate(input, other_aggregate);
+
+    BOOST_CHECK_THROW(converter.accumulate("twelve dozen", aggregate), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.accumulate("1e5000", aggregate), std::out_of_range);
+
+    BOOST_CHECK_EQUAL(aggregate.count(), 5);
+    BOOST_CHECK_EQUAL(aggregate.sum(), "2497.9375");
+    BOOST_CHECK_EQUAL(aggregate.min(), "-3.125");
+    BOOST_CHECK_EQUAL(aggregate.max(), "1250.5");
+
+    aggregate.merge(other_aggregate);
+
+    BOOST_CHECK_EQUAL(aggregate.count(), 8);
+    BOOST_CHECK_EQUAL(aggregate.sum(), "-11994584.0625");
+    BOOST_CHECK_EQUAL(aggregate.sum(','), "-11994584,0625");
+    BOOST_CHECK_EQUAL(aggregate.min(), "-12000000");
+    BOOST_CHECK_EQUAL(aggregate.max(), "1918");
+    BOOST_CHECK_EQUAL(converter.to_numeral(aggregate.max()), "one thousand nine hundred eighteen");
+
+    // Buckets are ordered by value: below -10^7, -10^0 to -10^1, zero, 10^-2 to 10^-1 and 10^3 to 10^4.
+    const auto histogram = aggregate.histogram();
+    BOOST_REQUIRE_EQUAL(histogram.size(), 5);
+    BOOST_CHECK(histogram[0].first.sign == -1 && histogram[0].first.exponent == 8 && histogram[0].second == 1);
+    BOOST_CHECK(histogram[1].first.sign == -1 && histogram[1].first.exponent == 1 && histogram[1].second == 1);
+    BOOST_CHECK(histogram[2].first.sign == 0 && histogram[2].second == 1);
+    BOOST_CHECK(histogram[3].first.sign == 1 && histogram[3].first.exponent == -1 && histogram[3].second == 1);
+    BOOST_CHECK(histogram[4].first.sign == 1 && histogram[4].first.exponent == 4 && histogram[4].second == 4);
+}
+
+BOOST_AUTO_TEST_CASE(result_cache)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "numero_test_result_cache.bin").string();
+    std::remove(path.c_str());
+
+    {
+        num::converter_c converter;
+        converter.enable_result_cache(std::make_shared<num::result_cache_c>(path, 16, 4096));
+
+        BOOST_CHECK_EQUAL(converter.to_numeral("1,234.5"), "one thousand two hundred thirty-four point five");
+        BOOST_CHECK_EQUAL(converter.to_number("twenty-one"), "21");
+        BOOST_CHECK_THROW(converter.to_number("twenty-one dozen"), std::invalid_argument);
+    }
+
+    {
+        // Results are cached per operation and options across instances.
+        const auto result_cache = std::make_shared<num::result_cache_c>(path);
+        BOOST_CHECK_EQUAL(result_cache->size(), 2);
+
+        std::string result;
+        const auto fingerprint = num::result_cache_c::fingerprint(num::conversion_options_t(), "to_number");
+        BOOST_CHECK(result_cache->find(fingerprint, "twenty-one", result));
+        BOOST_CHECK_EQUAL(result, "21");
+        BOOST_CHECK(!result_cache->find(fingerprint, "1,234.5", result));
+
+        num::conversion_options_t conversion_options;
+        conversion_options.naming_system = num::naming_system_t::long_scale;
+        BOOST_CHECK(!result_cache->find(num::result_cache_c::fingerprint(conversion_options, "to_number"),
+                                        "twenty-one", result));
+
+        // A full cache is no longer inserted into, but still found in.
+        for (int i = 0; result_cache->insert(fingerprint, std::to_string(i), std::string(i, 'x')); i++);
+        BOOST_CHECK(result_cache->find(fingerprint, "twenty-one", result));
+    }
+
+    {
+        // Cache files of another lexicon are recreated.
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        const auto lexicon_stamp = num::result_cache_c::lexicon_stamp() + 1;
+        file.seekp(offsetof(num::result_cache_header_t, lexicon_stamp));
+        file.write(reinterpret_cast<const char *>(&lexicon_stamp), sizeof(lexicon_stamp));
+    }
+
+    BOOST_CHECK_EQUAL(num::result_cache_c(path).size(), 0);
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(german)
+{
+    num::conversion_options_t conversion_options;
+    conversion_options.language = "de-de";
+    conversion_options.thousands_separator_symbol = '.';
+    conversion_options.decimal_separator_symbol = ',';
+    num::converter_c converter(conversion_options);
+
+    const std::vector<std::pair<std::string, std::string>> numbers_and_numerals = {
+        { "0", "null" },
+        { "1", "eins" },
+        { "21", "einundzwanzig" },
+        { "101", "einhunderteins" },
+        { "1.001", "eintausendeins" },
+        { "325.000", "dreihundertfünfundzwanzigtausend" },
+        { "1.000.000", "eine Million" },
+        { "2.000.001.000", "zwei Milliarden eintausend" },
+        { "101.000.000", "einhunderteine Millionen" },
+        { "3.000.000.000.000", "drei Billionen" },
+        { "-1.024", "minus eintausendvierundzwanzig" },
+        { "3,14", "drei Komma eins vier" }
+    };
+
+    for (const auto &[number, numeral] : numbers_and_numerals)
+    {
+        BOOST_CHECK_EQUAL(converter.to_numeral(number), numeral);
+        BOOST_CHECK_EQUAL(converter.to_number(numeral), number);
+    }
+
+    // Compounds are segmented regardless of case; the one is optional before "hundert" and "tausend".
+    BOOST_CHECK_EQUAL(converter.to_number("Hunderttausenddreizehn"), "100.013");
+    BOOST_CHECK_EQUAL(converter.to_number("zwei Millionen dreissig"), "2.000.030");
+    BOOST_CHECK(converter.is_numeral("fünf Millionen"));
+    BOOST_CHECK(converter.is_number("5.000.000"));
+
+    BOOST_CHECK_THROW(converter.to_number("zwei Millionen drei Millionen"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number("zweitausenddreitausend"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number("fünfundzwanzigsieben"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number("Million"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number("zwei Dutzend"), std::invalid_argument);
+    BOOST_CHECK_THROW(converter.to_number("drei Komma"), std::invalid_argument);
+
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("zwei Millionen"), "zwei Millionen");
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("Hunderttausenddreizehn"), "einhunderttausenddreizehn");
+    BOOST_CHECK_EQUAL(converter.canonicalize_numeral("minus drei Komma eins"), "minus drei Komma eins");
+    BOOST_CHECK(converter.is_canonical_numeral("zwei Milliarden eintausend"));
+    BOOST_CHECK(!converter.is_canonical_numeral("zwei Millionen dreissig"));
+    BOOST_CHECK(!converter.is_canonical_numeral("two million"));
+    BOOST_CHECK_THROW(converter.canonicalize_numeral("drei Komma"), std::invalid_argument);
+
+    const std::vector<uint64_t> values = { 0, 21, 1001, 2000001000 };
+    const auto column = converter.to_numeral_column(std::span<const uint64_t>(values));
+    BOOST_REQUIRE_EQUAL(column.size(), values.size());
+    for (std::size_t row = 0; row < values.size(); row++)
+        BOOST_CHECK_EQUAL(column[row], converter.to_numeral(std::to_string(values[row])));
+
+    BOOST_CHECK_THROW(num::numeral_range_c(1, 10, conversion_options), std::invalid_argument);
+
+    BOOST_CHECK_EQUAL(num::verbalize_numbers("Zahlen Sie 1.250,5 bis 3 Uhr.", conversion_options),
+                      "Zahlen Sie eintausendzweihundertfünfzig Komma fünf bis drei Uhr.");
+}